@@ -0,0 +1,356 @@
+#ifndef DEC0006_ALOCADOR_NODOS_H
+#define DEC0006_ALOCADOR_NODOS_H
+
+#include <cstddef>
+// std::size_t
+#include <memory>
+// std::shared_ptr
+#include <new>
+// placement new
+#include <utility>
+// std::forward
+#include <vector>
+// std::vector
+
+/**
+ * @brief Politica de alocacao que cria cada nodo com o new global.
+ *
+ * @tparam N O tipo de nodo alocado.
+ */
+template<typename N>
+class AlocadorNovo
+{
+public:
+    /**
+     * @brief Indica se o alocador libera todos os nodos de uma vez ao ser
+     * destruido, sem que cada nodo precise ser liberado individualmente.
+     *
+     */
+    static constexpr bool liberaEmBloco = false;
+
+    /**
+     * @brief Aloca e constroi um nodo.
+     *
+     * @param argumentos Os argumentos repassados a inicializacao do nodo.
+     * @return O nodo construido.
+     */
+    template<typename... Argumentos>
+    N* criar(Argumentos&&... argumentos)
+    {
+        return new N{std::forward<Argumentos>(argumentos)...};
+    }
+
+    /**
+     * @brief Destroi e libera um nodo criado por este alocador.
+     *
+     * @param nodo O nodo a ser liberado.
+     */
+    void destruir(N* nodo)
+    {
+        delete nodo;
+    }
+
+    /**
+     * @brief Indica quantos nodos serao criados em seguida. Nao tem efeito
+     * neste alocador.
+     *
+     */
+    void reservar(std::size_t)
+    {}
+
+    /**
+     * @brief Devolve a memoria de todos os nodos. Nao tem efeito neste
+     * alocador, em que cada nodo e liberado por destruir.
+     *
+     */
+    void liberarTudo()
+    {}
+
+    /**
+     * @brief Indica se este alocador e o unico dono de seus nodos. Como cada
+     * nodo e liberado individualmente, e sempre verdade.
+     *
+     */
+    bool exclusivo() const
+    {
+        return true;
+    }
+
+    /**
+     * @brief Indica se nodos criados por outro alocador podem ser liberados
+     * por este. Como todos usam o new global, e sempre verdade.
+     *
+     */
+    bool compartilhaCom(AlocadorNovo const&) const
+    {
+        return true;
+    }
+
+    /**
+     * @brief Passa a ser responsavel pelos nodos de outro alocador. Como todos
+     * usam o new global, nao ha nada a fazer.
+     *
+     * @return Sempre true.
+     */
+    bool absorver(AlocadorNovo&)
+    {
+        return true;
+    }
+};
+
+/**
+ * @brief Politica de alocacao que reserva nodos em blocos contiguos (slabs).
+ * Nodos liberados entram em uma lista de livres e sao reutilizados pelas
+ * proximas alocacoes; a memoria de todos os blocos e devolvida de uma vez,
+ * em tempo proporcional ao numero de blocos.
+ *
+ * Copias de um AlocadorSlab compartilham os mesmos blocos, que sao devolvidos
+ * quando a ultima copia e destruida. Alocadores que compartilham blocos nao
+ * devem ser usados por threads diferentes ao mesmo tempo.
+ *
+ * @tparam N O tipo de nodo alocado.
+ */
+template<typename N>
+class AlocadorSlab
+{
+public:
+    static constexpr bool liberaEmBloco = true;
+
+    AlocadorSlab():
+        _pool{std::make_shared<Pool>()}
+    {}
+
+    /**
+     * @brief Aloca e constroi um nodo, reutilizando um espaco liberado se
+     * houver algum.
+     *
+     * @param argumentos Os argumentos repassados a inicializacao do nodo.
+     * @return O nodo construido.
+     */
+    template<typename... Argumentos>
+    N* criar(Argumentos&&... argumentos)
+    {
+        Pool& pool = *_pool;
+        Espaco* espaco;
+
+        if (pool.livres != nullptr)
+        {
+            espaco = pool.livres;
+            pool.livres = espaco->proximoLivre;
+
+            if (pool.livres == nullptr)
+            {
+                pool.ultimoLivre = nullptr;
+            }
+        }
+        else
+        {
+            if (pool.usados == pool.capacidade)
+            {
+                pool.novoBloco();
+            }
+
+            espaco = pool.atual + pool.usados;
+            pool.usados++;
+        }
+
+        return new (espaco->dados) N{std::forward<Argumentos>(argumentos)...};
+    }
+
+    /**
+     * @brief Destroi um nodo e guarda seu espaco na lista de livres.
+     *
+     * @param nodo O nodo a ser liberado.
+     */
+    void destruir(N* nodo)
+    {
+        nodo->~N();
+
+        Pool& pool = *_pool;
+        Espaco* espaco = reinterpret_cast<Espaco*>(nodo);
+        espaco->proximoLivre = pool.livres;
+        pool.livres = espaco;
+
+        if (pool.ultimoLivre == nullptr)
+        {
+            pool.ultimoLivre = espaco;
+        }
+    }
+
+    /**
+     * @brief Garante que os proximos nodos criados, ate a quantidade dada,
+     * ocupem espacos contiguos de um mesmo bloco.
+     *
+     * @param quantidade A quantidade de nodos que serao criados em seguida.
+     */
+    void reservar(std::size_t quantidade)
+    {
+        Pool& pool = *_pool;
+
+        if (pool.capacidade - pool.usados < quantidade)
+        {
+            pool.novoBloco(quantidade);
+        }
+    }
+
+    /**
+     * @brief Devolve a memoria de todos os blocos, invalidando todos os nodos
+     * criados. Os destrutores dos nodos nao sao chamados. So deve ser chamado
+     * se nenhuma copia deste alocador tiver nodos vivos.
+     *
+     */
+    void liberarTudo()
+    {
+        _pool->liberarTudo();
+    }
+
+    /**
+     * @brief Indica se este alocador e o unico dono de seus blocos.
+     *
+     * @return true se nenhuma copia compartilha os blocos deste alocador.
+     */
+    bool exclusivo() const
+    {
+        return _pool.use_count() == 1;
+    }
+
+    /**
+     * @brief Indica se nodos criados por outro alocador podem ser liberados
+     * por este.
+     *
+     * @param outro O outro alocador.
+     * @return true se os dois alocadores compartilham os mesmos blocos.
+     */
+    bool compartilhaCom(AlocadorSlab const& outro) const
+    {
+        return _pool == outro._pool;
+    }
+
+    /**
+     * @brief Passa a ser dono dos blocos de outro alocador, em tempo
+     * proporcional ao numero de blocos, para que os nodos criados por ele
+     * possam ser liberados por este. So e possivel se o outro alocador for o
+     * unico dono de seus blocos; nesse caso, ele fica sem blocos.
+     *
+     * @param outro O alocador cujos blocos serao absorvidos.
+     * @return true se os blocos foram absorvidos.
+     */
+    bool absorver(AlocadorSlab& outro)
+    {
+        if (compartilhaCom(outro))
+        {
+            return true;
+        }
+
+        if (!outro.exclusivo())
+        {
+            return false;
+        }
+
+        Pool& pool = *_pool;
+        Pool& absorvido = *outro._pool;
+
+        pool.blocos.insert(pool.blocos.end(), absorvido.blocos.begin(), absorvido.blocos.end());
+
+        if (absorvido.livres != nullptr)
+        {
+            absorvido.ultimoLivre->proximoLivre = pool.livres;
+            pool.livres = absorvido.livres;
+
+            if (pool.ultimoLivre == nullptr)
+            {
+                pool.ultimoLivre = absorvido.ultimoLivre;
+            }
+        }
+
+        // continua alocando do bloco com mais espacos ainda nao usados
+        if (absorvido.capacidade - absorvido.usados > pool.capacidade - pool.usados)
+        {
+            pool.atual = absorvido.atual;
+            pool.capacidade = absorvido.capacidade;
+            pool.usados = absorvido.usados;
+        }
+
+        absorvido.blocos.clear();
+        absorvido.liberarTudo();
+        return true;
+    }
+
+private:
+    /**
+     * @brief Espaco de um nodo dentro de um bloco. Enquanto livre, guarda o
+     * proximo espaco livre.
+     *
+     */
+    union Espaco
+    {
+        Espaco* proximoLivre;
+        alignas(N) unsigned char dados[sizeof(N)];
+    };
+
+    /**
+     * @brief Os blocos e a lista de livres, compartilhados pelas copias do
+     * alocador.
+     *
+     */
+    struct Pool
+    {
+        std::vector<Espaco*> blocos;
+        Espaco* livres{nullptr};
+        Espaco* ultimoLivre{nullptr};
+        Espaco* atual{nullptr};
+        std::size_t capacidade{0};
+        std::size_t usados{0};
+
+        ~Pool()
+        {
+            liberarTudo();
+        }
+
+        /**
+         * @brief Reserva um novo bloco, com o dobro da capacidade do anterior
+         * ate o limite de capacidadeMaxima espacos, ou com a capacidade dada.
+         *
+         */
+        void novoBloco(std::size_t capacidade_minima = 0)
+        {
+            capacidade = (capacidade == 0) ? capacidadeInicial : capacidade * 2;
+
+            if (capacidade > capacidadeMaxima)
+            {
+                capacidade = capacidadeMaxima;
+            }
+
+            if (capacidade < capacidade_minima)
+            {
+                capacidade = capacidade_minima;
+            }
+
+            atual = new Espaco[capacidade];
+            blocos.push_back(atual);
+            usados = 0;
+        }
+
+        void liberarTudo()
+        {
+            for (Espaco* bloco : blocos)
+            {
+                delete[] bloco;
+            }
+
+            blocos.clear();
+            livres = nullptr;
+            ultimoLivre = nullptr;
+            atual = nullptr;
+            capacidade = 0;
+            usados = 0;
+        }
+    };
+
+    static constexpr std::size_t capacidadeInicial = 64;
+    static constexpr std::size_t capacidadeMaxima = 64 * 1024;
+
+    std::shared_ptr<Pool> _pool;
+};
+
+#endif
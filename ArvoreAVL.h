@@ -0,0 +1,3181 @@
+#ifndef ARVORE_AVL_HPP
+#define ARVORE_AVL_HPP
+
+#include "AlocadorNodos.h"
+#include "ArvoreCongelada.h"
+#include "EstatisticasAVL.h"
+#include "MinhaListaEncadeada.h"
+#include "PoolDeThreads.h"
+#include "RetratoAVL.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief quantas vezes a chave de um nodo foi inserida. Sem contagem, cada insercao cria um
+ * nodo e a contagem e sempre 1, sem ocupar espaco no nodo.
+ */
+template <bool ContaRepeticoes>
+struct ContagemDoNodo
+{
+    static constexpr int contagem = 1;
+};
+
+template <>
+struct ContagemDoNodo<true>
+{
+    int contagem{1};
+};
+
+template<typename T, bool ContaRepeticoes = false>
+struct Nodo : ContagemDoNodo<ContaRepeticoes>
+{
+    /**
+     * @brief constroi a chave diretamente no nodo, a partir dos argumentos do seu construtor
+     */
+    template <typename... Argumentos>
+    explicit Nodo(Argumentos&&... argumentos) : chave(std::forward<Argumentos>(argumentos)...)
+    {}
+
+    T chave;
+    int altura{0};
+    int tamanho{1};
+    Nodo* filhoEsquerda{nullptr};
+    Nodo* filhoDireita{nullptr}; 
+    Nodo* pai{nullptr};
+};
+
+/**
+ * @brief Representa uma árvore AVL. Nenhum metodo e virtual: as chamadas sao resolvidas em
+ * tempo de compilacao e os auxiliares do caminho de busca e de rebalanceamento podem ser
+ * expandidos em linha. Para usar a arvore pela interface ArvoreBinariaDeBusca, veja
+ * MinhaArvoreAVL.
+ *
+ * Com um comparador transparente, como std::less<>, as buscas aceitam chaves de outro tipo
+ * comparavel com T (por exemplo, std::string_view em uma arvore de std::string), sem criar
+ * uma copia da chave.
+ *
+ * @tparam T O tipo de dado guardado na árvore.
+ * @tparam Alocador A politica de alocacao dos nodos (AlocadorSlab ou AlocadorNovo).
+ * @tparam Comparador A ordem estrita das chaves; comparador(a, b) e verdade se a vem antes de b.
+ * @tparam ContaRepeticoes Se verdade, inserir uma chave que a arvore ja contem incrementa a
+ * contagem do seu nodo em vez de criar outro nodo. quantidade, selecionar, rank e os
+ * percursos consideram cada chave tantas vezes quanto a sua contagem.
+ * @tparam ColetaEstatisticas Se verdade, a arvore conta comparacoes, nodos visitados,
+ * rotacoes, subidas aos pais, alocacoes e liberacoes (veja estatisticas()). Se falso, nenhum
+ * contador existe e os registros sao eliminados pelo compilador.
+ */
+template <typename T, template <typename> class Alocador = AlocadorSlab, typename Comparador = std::less<T>,
+          bool ContaRepeticoes = false, bool ColetaEstatisticas = false>
+class ArvoreAVL : private ContadoresDaArvore<ColetaEstatisticas>
+{
+    /**
+     * @brief dentro da arvore, Nodo<T> e o nodo com ou sem contagem, conforme ContaRepeticoes
+     */
+    template <typename U>
+    using Nodo = ::Nodo<U, ContaRepeticoes>;
+
+    /**
+     * @brief cria e libera os nodos da arvore
+     */
+    Alocador<Nodo<T>> alocador;
+
+    Nodo<T>* raiz{nullptr};
+
+    /**
+     * @brief nodos da menor e da maior chave, mantidos pelas insercoes e remocoes; as rotacoes
+     * nao os alteram, pois preservam a ordem dos nodos
+     */
+    Nodo<T>* nodoMinimo{nullptr};
+    Nodo<T>* nodoMaximo{nullptr};
+
+    ComparadorDaArvore<Comparador, ColetaEstatisticas> comparador;
+
+public:
+    ArvoreAVL() = default;
+
+    /**
+     * @brief Cria uma arvore vazia que ordena as chaves com o comparador dado
+     */
+    explicit ArvoreAVL(Comparador comparador):
+        comparador{std::move(comparador)}
+    {}
+
+    /**
+     * @brief Constroi uma arvore perfeitamente balanceada a partir de chaves ordenadas, em O(n)
+     * @param primeiro inicio da sequencia de chaves, em ordem nao decrescente segundo o comparador
+     * @param ultimo fim da sequencia de chaves
+     * @param comparador a ordem das chaves
+     */
+    template <typename Iterador>
+    ArvoreAVL(Iterador primeiro, Iterador ultimo, Comparador comparador = Comparador()):
+        comparador{std::move(comparador)}
+    {
+        construirDeOrdenado(primeiro, ultimo);
+    }
+
+    ArvoreAVL(ArvoreAVL const&) = delete;
+    ArvoreAVL& operator=(ArvoreAVL const&) = delete;
+
+    /**
+     * @brief Move as chaves de outra arvore para uma nova arvore, que passa a
+     * compartilhar o alocador da outra. A outra arvore fica vazia.
+     */
+    ArvoreAVL(ArvoreAVL&& outra):
+        ContadoresDaArvore<ColetaEstatisticas>(outra), alocador{outra.alocador}, comparador{outra.comparador}
+    {
+        this->raiz = outra.raiz;
+        this->nodoMinimo = outra.nodoMinimo;
+        this->nodoMaximo = outra.nodoMaximo;
+        outra.raiz = nullptr;
+        outra.nodoMinimo = nullptr;
+        outra.nodoMaximo = nullptr;
+    }
+
+    ~ArvoreAVL()
+    {
+        limpar();
+    }
+
+    /**
+     * @brief Substitui o conteudo da arvore por uma arvore perfeitamente balanceada com as
+     * chaves dadas, em O(n) e sem rotacoes. Os nodos sao reservados de uma vez e dispostos
+     * contiguamente em ordem.
+     * @param primeiro inicio da sequencia de chaves, em ordem nao decrescente
+     * @param ultimo fim da sequencia de chaves
+     */
+    template <typename Iterador>
+    void construirDeOrdenado(Iterador primeiro, Iterador ultimo)
+    {
+        limpar();
+
+        int quantidade = 0;
+
+        if constexpr (ContaRepeticoes)
+        {
+            // chaves repetidas consecutivas ocupam um unico nodo
+            for (Iterador atual = primeiro; atual != ultimo; ++quantidade)
+            {
+                Iterador anterior = atual;
+
+                while (++atual != ultimo && !comparador(*anterior, *atual))
+                {
+                }
+            }
+        }
+        else
+        {
+            quantidade = static_cast<int>(std::distance(primeiro, ultimo));
+        }
+
+        alocador.reservar(quantidade);
+        this->raiz = construirRec(primeiro, ultimo, quantidade);
+        atualizaExtremos();
+    }
+
+    /**
+     * @brief Insere um lote de chaves de uma vez, com o mesmo resultado de chamar inserir para
+     * cada chave: chaves repetidas, no lote ou ja na arvore, sao todas mantidas (ou contadas,
+     * se a arvore conta repeticoes). O lote e ordenado e, conforme o seu tamanho m em relacao
+     * ao tamanho n da arvore:
+     * - lotes muito pequenos tem as chaves inseridas em ordem, uma a uma, de modo que cada
+     *   descida percorre quase o mesmo caminho da anterior, ja presente no cache;
+     * - lotes medios viram uma arvore balanceada, em O(m), que e intercalada com esta em
+     *   O(m log(n / m + 1)), visitando apenas os nodos nas divisas entre as chaves do lote;
+     * - lotes varias vezes maiores que a arvore sao intercalados com as chaves dela e todos
+     *   os nodos sao religados em uma arvore perfeitamente balanceada, em O(n + m).
+     * @param primeiro inicio do lote, em qualquer ordem
+     * @param ultimo fim do lote
+     * @param pool threads usadas para unir lotes grandes a arvores grandes
+     */
+    template <typename Entrada>
+    void inserirLote(Entrada primeiro, Entrada ultimo, PoolDeThreads& pool = PoolDeThreads::padrao())
+    {
+        std::vector<T> lote(primeiro, ultimo);
+
+        std::sort(lote.begin(), lote.end(), comparador);
+
+        if (lote.empty())
+        {
+            return;
+        }
+
+        long long m = static_cast<long long>(lote.size());
+        long long n = quantidade();
+
+        if (m * razaoInsercaoPorChave < n)
+        {
+            for (T& chave : lote)
+            {
+                insere(std::move(chave));
+            }
+        }
+        else if (m < n * razaoReconstrucao)
+        {
+            ArvoreAVL outra{alocador, comparador};
+            outra.construirDeOrdenado(std::make_move_iterator(lote.begin()), std::make_move_iterator(lote.end()));
+            operacaoDeConjunto(outra, pool, [this](Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& p) {
+                return intercalaRec(a, b, descartados, p);
+            });
+        }
+        else
+        {
+            intercalaEReconstroi(lote);
+        }
+    }
+
+    /**
+     * @brief Iterador bidirecional que percorre a arvore em ordem, seguindo os
+     * ponteiros entre os nodos, sem alocar memoria. Continua valido enquanto o
+     * nodo para o qual aponta nao for removido.
+     */
+    class Iterador
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const*;
+        using reference = T const&;
+
+        Iterador() = default;
+
+        reference operator*() const
+        {
+            return nodo->chave;
+        }
+
+        pointer operator->() const
+        {
+            return &nodo->chave;
+        }
+
+        Iterador& operator++()
+        {
+            if constexpr (ContaRepeticoes)
+            {
+                // cada repeticao da chave e uma posicao do percurso
+                if (++repeticao < nodo->contagem)
+                {
+                    return *this;
+                }
+
+                repeticao = 0;
+            }
+
+            nodo = getSucessor(nodo);
+            return *this;
+        }
+
+        Iterador operator++(int)
+        {
+            Iterador anterior = *this;
+            ++*this;
+            return anterior;
+        }
+
+        Iterador& operator--()
+        {
+            if constexpr (ContaRepeticoes)
+            {
+                if (repeticao > 0)
+                {
+                    --repeticao;
+                    return *this;
+                }
+            }
+
+            // decrementar end() leva a maior chave
+            nodo = (nodo != nullptr) ? getAntecessor(nodo) : arvore->nodoMaximo;
+
+            if constexpr (ContaRepeticoes)
+            {
+                repeticao = nodo->contagem - 1;
+            }
+
+            return *this;
+        }
+
+        Iterador operator--(int)
+        {
+            Iterador anterior = *this;
+            --*this;
+            return anterior;
+        }
+
+        bool operator==(Iterador const& outro) const
+        {
+            return nodo == outro.nodo && repeticao == outro.repeticao;
+        }
+
+        bool operator!=(Iterador const& outro) const
+        {
+            return !(*this == outro);
+        }
+
+    private:
+        friend class ArvoreAVL;
+
+        Iterador(ArvoreAVL const* arvore, Nodo<T>* nodo):
+            arvore{arvore}, nodo{nodo}
+        {}
+
+        ArvoreAVL const* arvore{nullptr};
+        Nodo<T>* nodo{nullptr};
+
+        // qual das repeticoes da chave do nodo, quando a arvore conta repeticoes
+        int repeticao{0};
+    };
+
+    using iterator = Iterador;
+    using const_iterator = Iterador;
+    using reverse_iterator = std::reverse_iterator<Iterador>;
+    using const_reverse_iterator = std::reverse_iterator<Iterador>;
+
+    /**
+     * @brief Iterador para a menor chave da arvore
+     */
+    Iterador begin() const
+    {
+        return Iterador{this, this->nodoMinimo};
+    }
+
+    /**
+     * @brief Iterador para a posicao apos a maior chave da arvore
+     */
+    Iterador end() const
+    {
+        return Iterador{this, nullptr};
+    }
+
+    /**
+     * @brief Iterador reverso para a maior chave da arvore
+     */
+    reverse_iterator rbegin() const
+    {
+        return reverse_iterator{end()};
+    }
+
+    /**
+     * @brief Iterador reverso para a posicao antes da menor chave da arvore
+     */
+    reverse_iterator rend() const
+    {
+        return reverse_iterator{begin()};
+    }
+
+private:
+    /**
+     * @brief cria uma arvore vazia que compartilha o alocador e o comparador de outra
+     */
+    ArvoreAVL(Alocador<Nodo<T>> const& alocador, Comparador const& comparador):
+        alocador{alocador}, comparador{comparador}
+    {}
+
+    /**
+     * @brief remove todos os nodos da arvore
+     */
+    void limpar()
+    {
+        /**
+         * se o alocador devolve seus blocos de uma vez e as chaves nao precisam
+         * de destrutor, nao e necessario visitar cada nodo
+         */
+        bool libera_em_bloco = Alocador<Nodo<T>>::liberaEmBloco && alocador.exclusivo();
+
+        if (!libera_em_bloco || !std::is_trivially_destructible<T>::value)
+        {
+            destrutor(this->raiz);
+        }
+        else if constexpr (ColetaEstatisticas)
+        {
+            std::vector<int> histograma = histogramaDeProfundidades();
+            this->registraLiberacoes(std::accumulate(histograma.begin(), histograma.end(), 0LL));
+        }
+
+        if (libera_em_bloco)
+        {
+            alocador.liberarTudo();
+        }
+
+        this->raiz = nullptr;
+        this->nodoMinimo = nullptr;
+        this->nodoMaximo = nullptr;
+    }
+
+    /**
+     * @brief recalcula os nodos da menor e da maior chave, em O(log n), apos operacoes que
+     * trocam subarvores inteiras, como construcoes, juncoes, divisoes e operacoes de conjunto
+     */
+    void atualizaExtremos()
+    {
+        this->nodoMinimo = getMaisEsquerda(this->raiz);
+        this->nodoMaximo = getMaisDireita(this->raiz);
+    }
+
+    /**
+     * @brief atualiza os nodos da menor e da maior chave apos ligar uma nova folha: ela so e
+     * a nova menor chave se foi ligada a esquerda da antiga, e a nova maior, a direita da antiga
+     * @param nodo folha recem-ligada a arvore
+     */
+    void anotaExtremo(Nodo<T> *nodo)
+    {
+        if (nodo->pai == nullptr)
+        {
+            this->nodoMinimo = nodo;
+            this->nodoMaximo = nodo;
+        }
+        else if (nodo->pai == this->nodoMinimo && nodo->pai->filhoEsquerda == nodo)
+        {
+            this->nodoMinimo = nodo;
+        }
+        else if (nodo->pai == this->nodoMaximo && nodo->pai->filhoDireita == nodo)
+        {
+            this->nodoMaximo = nodo;
+        }
+    }
+
+    /**
+     * @brief cria um nodo com o alocador da arvore
+     * @param argumentos argumentos do construtor da chave
+     */
+    template <typename... Argumentos>
+    Nodo<T> *criaNodo(Argumentos&&... argumentos)
+    {
+        this->registraAlocacao();
+        return alocador.criar(std::forward<Argumentos>(argumentos)...);
+    }
+
+    /**
+     * @brief libera um nodo criado pelo alocador da arvore
+     */
+    void destroiNodo(Nodo<T> *nodo)
+    {
+        this->registraLiberacoes(1);
+        alocador.destruir(nodo);
+    }
+
+    void destrutor(Nodo<T>* raiz)
+    {
+        if (raiz != nullptr)
+        {
+            destrutor(raiz->filhoEsquerda);
+            destrutor(raiz->filhoDireita);  
+
+            destroiNodo(raiz);
+        }
+        
+    }
+
+    /**
+     * @brief constroi recursivamente uma subarvore balanceada consumindo chaves em ordem,
+     * de modo que os nodos sao alocados na ordem das chaves
+     * @param atual proxima chave a ser consumida; avanca a cada nodo criado
+     * @param ultimo fim das chaves
+     * @param quantidade quantidade de nodos da subarvore
+     * @return raiz da subarvore, ou nullptr se @param quantidade e 0
+     */
+    template <typename Iterador>
+    Nodo<T> *construirRec(Iterador& atual, Iterador ultimo, int quantidade)
+    {
+        if (quantidade == 0)
+        {
+            return nullptr;
+        }
+
+        int quantidade_esquerda = (quantidade - 1) / 2;
+
+        Nodo<T> *esquerda = construirRec(atual, ultimo, quantidade_esquerda);
+        Nodo<T> *nodo = criaNodo(*atual);
+        ++atual;
+
+        if constexpr (ContaRepeticoes)
+        {
+            for (; atual != ultimo && !comparador(nodo->chave, *atual); ++atual)
+            {
+                nodo->contagem++;
+            }
+        }
+
+        Nodo<T> *direita = construirRec(atual, ultimo, quantidade - 1 - quantidade_esquerda);
+
+        nodo->filhoEsquerda = esquerda;
+        nodo->filhoDireita = direita;
+
+        if (esquerda != nullptr)
+        {
+            esquerda->pai = nodo;
+        }
+
+        if (direita != nullptr)
+        {
+            direita->pai = nodo;
+        }
+
+        ajustaAltura(nodo);
+        return nodo;
+    }
+
+    /**
+     * @brief limites de inserirLote, medidos com avl_bench: a arvore precisa ser mais que
+     * razaoInsercaoPorChave vezes maior que o lote para que inserir as chaves uma a uma seja
+     * mais rapido que intercalar as arvores, e o lote precisa ser razaoReconstrucao vezes
+     * maior que a arvore para que percorrer e religar todos os nodos seja mais rapido que
+     * intercala-las
+     */
+    static constexpr long long razaoInsercaoPorChave = 128;
+    static constexpr long long razaoReconstrucao = 4;
+
+    /**
+     * @brief intercala as chaves ordenadas de um lote com as da arvore e religa todos os nodos
+     * em uma arvore perfeitamente balanceada; os nodos existentes sao reaproveitados. Se a
+     * arvore conta repeticoes, cada chave do lote igual a do ultimo nodo intercalado
+     * incrementa a contagem dele em vez de criar outro nodo.
+     * @param lote chaves a serem inseridas, que sao movidas para os novos nodos
+     */
+    void intercalaEReconstroi(std::vector<T>& lote)
+    {
+        std::vector<Nodo<T> *> nodos;
+        nodos.reserve(static_cast<std::size_t>(quantidade()) + lote.size());
+        alocador.reservar(static_cast<int>(lote.size()));
+
+        Nodo<T> *nodo = this->nodoMinimo;
+        typename std::vector<T>::iterator chave = lote.begin();
+
+        while (nodo != nullptr || chave != lote.end())
+        {
+            // entre chaves iguais, o nodo da arvore vem primeiro
+            if (chave == lote.end() || (nodo != nullptr && !comparador(*chave, nodo->chave)))
+            {
+                nodos.push_back(nodo);
+                nodo = getSucessor(nodo);
+                continue;
+            }
+
+            if constexpr (ContaRepeticoes)
+            {
+                if (!nodos.empty() && !comparador(nodos.back()->chave, *chave))
+                {
+                    nodos.back()->contagem++;
+                    ++chave;
+                    continue;
+                }
+            }
+
+            nodos.push_back(criaNodo(std::move(*chave)));
+            ++chave;
+        }
+
+        this->raiz = religa(nodos.data(), static_cast<int>(nodos.size()));
+        this->raiz->pai = nullptr;
+        this->nodoMinimo = nodos.front();
+        this->nodoMaximo = nodos.back();
+    }
+
+    /**
+     * @brief religa nodos em ordem em uma subarvore perfeitamente balanceada
+     * @param nodos nodos da subarvore, em ordem
+     * @param quantidade quantidade de nodos
+     * @return raiz da subarvore, ou nullptr se @param quantidade e 0
+     */
+    Nodo<T> *religa(Nodo<T> *const *nodos, int quantidade)
+    {
+        if (quantidade == 0)
+        {
+            return nullptr;
+        }
+
+        int quantidade_esquerda = (quantidade - 1) / 2;
+
+        Nodo<T> *nodo = nodos[quantidade_esquerda];
+        nodo->filhoEsquerda = religa(nodos, quantidade_esquerda);
+        nodo->filhoDireita = religa(nodos + quantidade_esquerda + 1, quantidade - 1 - quantidade_esquerda);
+
+        if (nodo->filhoEsquerda != nullptr)
+        {
+            nodo->filhoEsquerda->pai = nodo;
+        }
+
+        if (nodo->filhoDireita != nullptr)
+        {
+            nodo->filhoDireita->pai = nodo;
+        }
+
+        ajustaAltura(nodo);
+        return nodo;
+    }
+
+public:
+    /**
+     * @brief Verifica se a arvore esta vazia
+     * @return Verdade se a arvore esta vazia.
+     */
+    bool vazia() const
+    {
+        return (this->raiz == nullptr) ? true : false;
+    };
+
+    /**
+     * @brief Retornar quantidade de chaves na arvore
+     * @return Numero natural que representa a quantidade de chaves na arvore
+     */
+    int quantidade() const
+    {
+        return tamanhoDe(this->raiz);
+    };
+
+private:
+    /**
+     * @brief retorna a quantidade de nodos da subarvore, mantida em cada nodo
+     * @param nodo raiz da subarvore, possivelmente nullptr
+     * @return quantidade de nodos da subarvore, 0 se @param nodo e nullptr
+     */
+    int tamanhoDe(Nodo<T> *nodo) const
+    {
+        return (nodo != nullptr) ? nodo->tamanho : 0;
+    }
+
+    /**
+     * @brief retorna a altura de uma subarvore
+     * @param nodo raiz da subarvore, possivelmente nullptr
+     * @return altura da subarvore, -1 se @param nodo e nullptr
+     */
+    static int alturaDe(Nodo<T> *nodo)
+    {
+        return (nodo != nullptr) ? nodo->altura : -1;
+    }
+
+    /**
+     * @brief conta as chaves menores (ou menores ou iguais) que uma chave, somando o tamanho
+     * das subarvores a esquerda do caminho de busca
+     * @param chave chave de referencia
+     * @param inclusivo se verdade, conta tambem as chaves iguais a @param chave
+     * @return quantidade de chaves contadas
+     */
+    template <typename K>
+    int contaMenores(K const& chave, bool inclusivo) const
+    {
+        Nodo<T> *nodo = this->raiz;
+        int menores = 0;
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+
+            if (comparador(nodo->chave, chave) || (inclusivo && !comparador(chave, nodo->chave)))
+            {
+                menores += tamanhoDe(nodo->filhoEsquerda) + nodo->contagem;
+                nodo = nodo->filhoDireita;
+            }
+            else
+            {
+                nodo = nodo->filhoEsquerda;
+            }
+        }
+
+        return menores;
+    }
+
+    /**
+     * @brief procura o primeiro nodo, em ordem, cuja chave nao e menor que uma chave
+     * @param chave chave de referencia
+     * @return nodo encontrado, ou nullptr se todas as chaves sao menores
+     */
+    template <typename K>
+    Nodo<T> *limiteInferior(K const& chave) const
+    {
+        Nodo<T> *nodo = this->raiz;
+        Nodo<T> *limite = nullptr;
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+
+            if (comparador(nodo->chave, chave))
+            {
+                nodo = nodo->filhoDireita;
+            }
+            else
+            {
+                limite = nodo;
+                nodo = nodo->filhoEsquerda;
+            }
+        }
+
+        return limite;
+    }
+
+    /**
+     * @brief procura o primeiro nodo, em ordem, cuja chave e maior que uma chave
+     * @param chave chave de referencia
+     * @return nodo encontrado, ou nullptr se nenhuma chave e maior
+     */
+    template <typename K>
+    Nodo<T> *limiteSuperior(K const& chave) const
+    {
+        Nodo<T> *nodo = this->raiz;
+        Nodo<T> *limite = nullptr;
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+
+            if (comparador(chave, nodo->chave))
+            {
+                limite = nodo;
+                nodo = nodo->filhoEsquerda;
+            }
+            else
+            {
+                nodo = nodo->filhoDireita;
+            }
+        }
+
+        return limite;
+    }
+
+    /**
+     * @brief procura um nodo a partir do valor da sua chave
+     * @param chave chave a ser procurada na arvore
+     * @param nodo raiz da arvore/subarvore
+     * @return nodo que contem a chave
+     */
+    template <typename K>
+    Nodo<T> *procuraChave(K const& chave, Nodo<T> *nodo) const
+    {
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+
+            if (comparador(chave, nodo->chave))
+            {
+                nodo = nodo->filhoEsquerda;
+            }
+            else if (comparador(nodo->chave, chave))
+            {
+                nodo = nodo->filhoDireita;
+            }
+            else
+            {
+                return nodo;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief substitui o filho de um nodo, atualizando o ponteiro para o pai do novo filho
+     * @param pai nodo cujo filho sera substituido (nullptr se o antigo filho e a raiz)
+     * @param antigo filho atual de @param pai
+     * @param novo nodo que ocupara a posicao de @param antigo
+     */
+    void substituiFilho(Nodo<T> *pai, Nodo<T> *antigo, Nodo<T> *novo)
+    {
+        if (pai == nullptr)
+        {
+            // subarvores desligadas (durante divisoes e juncoes) nao alteram a raiz
+            if (this->raiz == antigo)
+            {
+                this->raiz = novo;
+            }
+        }
+        else if (pai->filhoEsquerda == antigo)
+        {
+            pai->filhoEsquerda = novo;
+        }
+        else
+        {
+            pai->filhoDireita = novo;
+        }
+
+        if (novo != nullptr)
+        {
+            novo->pai = pai;
+        }
+    }
+
+    /*  virtual Nodo<T>* procuraPosicao(T chave, Nodo<T>* nodo) const{
+
+         if (chave < nodo->chave)
+         {
+             if (nodo->filhoEsquerda != nullptr)
+             {
+                 return procuraPosicao(chave, nodo->filhoEsquerda);
+             }
+         }
+
+         if (chave > nodo->chave)
+         {
+             if (nodo->filhoDireita != nullptr)
+             {
+                 return procuraPosicao(chave, nodo->filhoDireita);
+             }
+         }
+
+         return nodo;
+     } */
+
+public:
+    /**
+     * @brief Verifica se a arvore contem uma chave
+     * @param chave chave a ser procurada na arvore
+     * @return Verdade se a arvore contem a chave
+     */
+    bool contem(T const& chave) const
+    {
+        if (!vazia())
+        {
+            if (procuraChave(chave, this->raiz) != nullptr)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    /**
+     * @brief Verifica se a arvore contem uma chave equivalente a uma chave de outro tipo;
+     * disponivel apenas com comparador transparente
+     * @param chave chave a ser procurada na arvore
+     * @return Verdade se a arvore contem a chave
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    bool contem(K const& chave) const
+    {
+        return procuraChave(chave, this->raiz) != nullptr;
+    }
+
+    /**
+     * @brief Procura uma chave na arvore
+     * @param chave chave a ser procurada na arvore
+     * @return Iterador para a chave, ou end() se a arvore nao contem a chave
+     */
+    Iterador procurar(T const& chave) const
+    {
+        return Iterador{this, procuraChave(chave, this->raiz)};
+    }
+
+    /**
+     * @brief Procura uma chave equivalente a uma chave de outro tipo; disponivel apenas com
+     * comparador transparente
+     * @param chave chave a ser procurada na arvore
+     * @return Iterador para a chave, ou end() se a arvore nao contem a chave
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    Iterador procurar(K const& chave) const
+    {
+        return Iterador{this, procuraChave(chave, this->raiz)};
+    }
+
+    /*  virtual bool contemRec(T chave, Nodo<T>* nodo) const{
+         if (chave < nodo->chave)
+         {
+             if (nodo->filhoEsquerda != nullptr)
+             {
+                 contemRec(nodo->filhoEsquerda);
+             } else {
+                 return false;
+             }
+         }
+
+         if (chave > nodo->chave)
+         {
+             if (nodo->filhoDireita != nullptr)
+             {
+                 contemRec(nodo->filhoDireita);
+             } else {
+                 return false;
+             }
+         }
+
+         return true;
+
+
+     } */
+
+    /**
+     * @brief Retorna a altura da (sub)arvore
+     * @param chave chave que é raiz da (sub)arvore cuja altura queremos.
+     * @return Numero inteiro representando a altura da (subarvore). Se chave nao esta na arvore, retorna std::nullopt
+     */
+    std::optional<int> altura(T const& chave) const
+    {
+        if (!vazia())
+        {
+            Nodo<T> *nodo = procuraChave(chave, this->raiz);
+            if (nodo != nullptr)
+            {
+                return nodo->altura;
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        return std::nullopt;
+    };
+
+    /**
+     * @brief Busca a k-esima menor chave da arvore
+     * @param k posicao da chave na arvore em ordem, na faixa [0, quantidade)
+     * @return A k-esima menor chave. Se k esta fora da faixa, retorna std::nullopt
+     */
+    std::optional<T> selecionar(int k) const
+    {
+        if (k < 0 || k >= quantidade())
+        {
+            return std::nullopt;
+        }
+
+        Nodo<T> *nodo = this->raiz;
+
+        /**
+         * desce pela arvore comparando k com o tamanho da subarvore a esquerda,
+         * que e a posicao da chave do nodo dentro da subarvore
+         */
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+
+            int tamanho_esquerda = tamanhoDe(nodo->filhoEsquerda);
+
+            if (k < tamanho_esquerda)
+            {
+                nodo = nodo->filhoEsquerda;
+            }
+            else if (k >= tamanho_esquerda + nodo->contagem)
+            {
+                k -= tamanho_esquerda + nodo->contagem;
+                nodo = nodo->filhoDireita;
+            }
+            else
+            {
+                return nodo->chave;
+            }
+        }
+
+        return std::nullopt;
+    };
+
+    /**
+     * @brief Conta as chaves da arvore estritamente menores que uma chave
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return Numero natural que representa a posicao em que a chave estaria na arvore em ordem
+     */
+    int rank(T const& chave) const
+    {
+        return contaMenores(chave, false);
+    };
+
+    /**
+     * @brief Conta as chaves da arvore estritamente menores que uma chave de outro tipo;
+     * disponivel apenas com comparador transparente
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return Numero natural que representa a posicao em que a chave estaria na arvore em ordem
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    int rank(K const& chave) const
+    {
+        return contaMenores(chave, false);
+    }
+
+    /**
+     * @brief Conta as chaves da arvore no intervalo [inicio, fim]
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @return Numero natural que representa a quantidade de chaves no intervalo
+     */
+    int contarIntervalo(T const& inicio, T const& fim) const
+    {
+        if (comparador(fim, inicio))
+        {
+            return 0;
+        }
+
+        return contaMenores(fim, true) - contaMenores(inicio, false);
+    };
+
+    /**
+     * @brief Conta as chaves da arvore no intervalo [inicio, fim], dado por chaves de outro
+     * tipo; disponivel apenas com comparador transparente
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @return Numero natural que representa a quantidade de chaves no intervalo
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    int contarIntervalo(K const& inicio, K const& fim) const
+    {
+        if (comparador(fim, inicio))
+        {
+            return 0;
+        }
+
+        return contaMenores(fim, true) - contaMenores(inicio, false);
+    }
+
+    /**
+     * @brief Visita em ordem as chaves da arvore no intervalo [inicio, fim], sem percorrer
+     * as subarvores fora do intervalo
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @param visitante funcao chamada com cada chave; se retorna bool, false interrompe a visita
+     */
+    template <typename Visitante>
+    void visitarIntervalo(T const& inicio, T const& fim, Visitante&& visitante) const
+    {
+        for (Nodo<T> *nodo = limiteInferior(inicio); nodo != nullptr && !comparador(fim, nodo->chave); nodo = getSucessor(nodo))
+        {
+            if (!visita(nodo, visitante))
+            {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Visita as chaves da arvore em ordem, sem alocar memoria: o percurso e iterativo,
+     * com uma pilha de tamanho fixo
+     * @param visitante funcao chamada com cada chave; se retorna bool, false interrompe a visita
+     */
+    template <typename Visitante>
+    void visitarEmOrdem(Visitante&& visitante) const
+    {
+        Nodo<T> *pilha[alturaMaxima];
+        int topo = 0;
+        Nodo<T> *nodo = this->raiz;
+
+        while (nodo != nullptr || topo > 0)
+        {
+            for (; nodo != nullptr; nodo = nodo->filhoEsquerda)
+            {
+                pilha[topo++] = nodo;
+            }
+
+            nodo = pilha[--topo];
+
+            if (!visita(nodo, visitante))
+            {
+                return;
+            }
+
+            nodo = nodo->filhoDireita;
+        }
+    }
+
+    /**
+     * @brief Visita as chaves da arvore em pre-ordem, sem alocar memoria: o percurso e
+     * iterativo, com uma pilha de tamanho fixo
+     * @param visitante funcao chamada com cada chave; se retorna bool, false interrompe a visita
+     */
+    template <typename Visitante>
+    void visitarPreOrdem(Visitante&& visitante) const
+    {
+        Nodo<T> *pilha[alturaMaxima];
+        int topo = 0;
+        Nodo<T> *nodo = this->raiz;
+
+        while (nodo != nullptr || topo > 0)
+        {
+            // desce pela esquerda, guardando as subarvores a direita que faltam visitar
+            if (nodo == nullptr)
+            {
+                nodo = pilha[--topo];
+            }
+
+            if (!visita(nodo, visitante))
+            {
+                return;
+            }
+
+            if (nodo->filhoDireita != nullptr)
+            {
+                pilha[topo++] = nodo->filhoDireita;
+            }
+
+            nodo = nodo->filhoEsquerda;
+        }
+    }
+
+    /**
+     * @brief Visita as chaves da arvore em pos-ordem, sem alocar memoria: o percurso e
+     * iterativo, com uma pilha de tamanho fixo
+     * @param visitante funcao chamada com cada chave; se retorna bool, false interrompe a visita
+     */
+    template <typename Visitante>
+    void visitarPosOrdem(Visitante&& visitante) const
+    {
+        Nodo<T> *pilha[alturaMaxima];
+        int topo = 0;
+        Nodo<T> *nodo = this->raiz;
+        Nodo<T> *visitado = nullptr;
+
+        while (nodo != nullptr || topo > 0)
+        {
+            for (; nodo != nullptr; nodo = nodo->filhoEsquerda)
+            {
+                pilha[topo++] = nodo;
+            }
+
+            Nodo<T> *proximo = pilha[topo - 1];
+
+            // a subarvore a direita e visitada antes do nodo, na primeira vez em que ele e o topo
+            if (proximo->filhoDireita != nullptr && proximo->filhoDireita != visitado)
+            {
+                nodo = proximo->filhoDireita;
+                continue;
+            }
+
+            if (!visita(proximo, visitante))
+            {
+                return;
+            }
+
+            visitado = proximo;
+            topo--;
+        }
+    }
+
+private:
+    /**
+     * @brief altura maxima de uma arvore AVL com ate std::numeric_limits<int>::max() nodos,
+     * cerca de 1,44 log2(n), com folga; limita a pilha dos percursos
+     */
+    static constexpr int alturaMaxima = 64;
+
+    /**
+     * @brief chama o visitante com a chave de um nodo, tantas vezes quanto a sua contagem
+     * @return Falso se o visitante interrompeu a visita
+     */
+    template <typename Visitante>
+    static bool visita(Nodo<T> *nodo, Visitante& visitante)
+    {
+        for (int repeticao = 0; repeticao < nodo->contagem; repeticao++)
+        {
+            if constexpr (std::is_same<std::invoke_result_t<Visitante&, T const&>, bool>::value)
+            {
+                if (!visitante(static_cast<T const&>(nodo->chave)))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                visitante(static_cast<T const&>(nodo->chave));
+            }
+        }
+
+        return true;
+    }
+
+public:
+
+    /**
+     * @brief Retorna os iteradores que delimitam as chaves no intervalo [inicio, fim]
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @return par com o iterador para a primeira chave do intervalo e o iterador para a
+     * posicao apos a ultima
+     */
+    std::pair<Iterador, Iterador> intervalo(T const& inicio, T const& fim) const
+    {
+        if (comparador(fim, inicio))
+        {
+            return {end(), end()};
+        }
+
+        return {Iterador{this, limiteInferior(inicio)}, Iterador{this, limiteSuperior(fim)}};
+    }
+
+    /**
+     * @brief Retorna a menor chave da arvore, em O(1)
+     * @return A menor chave. Se a arvore esta vazia, retorna std::nullopt
+     */
+    std::optional<T> minimo() const
+    {
+        return chaveDe(this->nodoMinimo);
+    }
+
+    /**
+     * @brief Retorna a maior chave da arvore, em O(1)
+     * @return A maior chave. Se a arvore esta vazia, retorna std::nullopt
+     */
+    std::optional<T> maximo() const
+    {
+        return chaveDe(this->nodoMaximo);
+    }
+
+    /**
+     * @brief Procura a primeira chave, em ordem, que nao e menor que uma chave, em O(log n)
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return Iterador para a chave encontrada, ou end() se todas as chaves sao menores
+     */
+    Iterador lower_bound(T const& chave) const
+    {
+        return Iterador{this, limiteInferior(chave)};
+    }
+
+    /**
+     * @brief Como lower_bound(T const&), com uma chave de outro tipo; disponivel apenas com
+     * comparador transparente
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    Iterador lower_bound(K const& chave) const
+    {
+        return Iterador{this, limiteInferior(chave)};
+    }
+
+    /**
+     * @brief Procura a primeira chave, em ordem, que e maior que uma chave, em O(log n)
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return Iterador para a chave encontrada, ou end() se nenhuma chave e maior
+     */
+    Iterador upper_bound(T const& chave) const
+    {
+        return Iterador{this, limiteSuperior(chave)};
+    }
+
+    /**
+     * @brief Como upper_bound(T const&), com uma chave de outro tipo; disponivel apenas com
+     * comparador transparente
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    Iterador upper_bound(K const& chave) const
+    {
+        return Iterador{this, limiteSuperior(chave)};
+    }
+
+    /**
+     * @brief Busca a menor chave maior ou igual a uma chave (ceiling), em O(log n)
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return A chave encontrada. Se todas as chaves sao menores, retorna std::nullopt
+     */
+    std::optional<T> teto(T const& chave) const
+    {
+        return chaveDe(limiteInferior(chave));
+    }
+
+    /**
+     * @brief Busca a maior chave menor ou igual a uma chave (floor), em O(log n)
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return A chave encontrada. Se todas as chaves sao maiores, retorna std::nullopt
+     */
+    std::optional<T> piso(T const& chave) const
+    {
+        return chaveDe(ultimoAntes(chave, true));
+    }
+
+    /**
+     * @brief Busca a menor chave estritamente maior que uma chave, em O(log n)
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return A chave seguinte. Se nenhuma chave e maior, retorna std::nullopt
+     */
+    std::optional<T> sucessor(T const& chave) const
+    {
+        return chaveDe(limiteSuperior(chave));
+    }
+
+    /**
+     * @brief Busca a maior chave estritamente menor que uma chave, em O(log n)
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return A chave anterior. Se nenhuma chave e menor, retorna std::nullopt
+     */
+    std::optional<T> antecessor(T const& chave) const
+    {
+        return chaveDe(ultimoAntes(chave, false));
+    }
+
+private:
+    /**
+     * @brief procura o ultimo nodo, em ordem, cuja chave e menor (ou menor ou igual) que uma chave
+     * @param chave chave de referencia
+     * @param inclusivo se verdade, aceita tambem chaves iguais a @param chave
+     * @return nodo encontrado, ou nullptr se nenhuma chave e aceita
+     */
+    template <typename K>
+    Nodo<T> *ultimoAntes(K const& chave, bool inclusivo) const
+    {
+        Nodo<T> *nodo = this->raiz;
+        Nodo<T> *limite = nullptr;
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+
+            if (comparador(nodo->chave, chave) || (inclusivo && !comparador(chave, nodo->chave)))
+            {
+                limite = nodo;
+                nodo = nodo->filhoDireita;
+            }
+            else
+            {
+                nodo = nodo->filhoEsquerda;
+            }
+        }
+
+        return limite;
+    }
+
+    /**
+     * @brief retorna a chave de um nodo, ou std::nullopt se ele e nullptr
+     */
+    static std::optional<T> chaveDe(Nodo<T> *nodo)
+    {
+        if (nodo == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return nodo->chave;
+    }
+
+public:
+    /* virtual std::optional<int> alturaRec(T chave, Nodo<T>* nodo) const{
+        if (chave < nodo->chave)
+        {
+            if (nodo->filhoEsquerda =! nullptr)
+            {
+                alturaRec(chave ,nodo->filhoEsquerda);
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        if (chave > nodo->chave)
+        {
+            if (nodo->filhoDireita =! nullptr)
+            {
+                alturaRec(chave, nodo->filhoDireita);
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        return nodo->altura;
+    } */
+
+    /**
+     * @brief Cria, em O(n), um indice imutavel com as chaves da arvore, em que as buscas
+     * percorrem um vetor em vez de seguir ponteiros. Alteracoes posteriores na arvore nao
+     * aparecem no indice
+     * @return Indice com as chaves atuais da arvore
+     */
+    ArvoreCongelada<T, Comparador> congelar() const
+    {
+        return ArvoreCongelada<T, Comparador>(begin(), end(), comparador);
+    }
+
+    /**
+     * @brief Grava um retrato binario da arvore em um fluxo, percorrendo as chaves em ordem e
+     * gravando-as em blocos grandes (o formato esta descrito em RetratoAVL.h). Erros de
+     * escrita ficam registrados no estado do fluxo.
+     * @param saida fluxo de destino, aberto em modo binario
+     * @param serializador grava cada chave; o padrao copia os bytes de chaves trivialmente
+     * copiaveis
+     */
+    template <typename Serializador = SerializadorTrivial<T>>
+    void salvar(std::ostream& saida, Serializador const& serializador = Serializador()) const
+    {
+        EscritorDeRetrato escritor{saida};
+
+        escritor.escrever(retrato::assinatura, sizeof(retrato::assinatura));
+        escritor.escreverValor(retrato::versao);
+        escritor.escreverValor(tamanhoDaChave<Serializador>());
+        escritor.escreverValor(std::uint32_t{0});
+        escritor.escreverValor(static_cast<std::uint64_t>(quantidade()));
+
+        for (Nodo<T> *nodo = getMaisEsquerda(this->raiz); nodo != nullptr; nodo = getSucessor(nodo))
+        {
+            for (int repeticao = 0; repeticao < nodo->contagem; repeticao++)
+            {
+                serializador.escrever(nodo->chave, escritor);
+            }
+        }
+
+        escritor.finalizar();
+    }
+
+    /**
+     * @brief Substitui o conteudo da arvore pelo de um retrato gravado por salvar(). As chaves
+     * sao lidas para um vetor e a arvore e construida balanceada em O(n), sem rotacoes. Se o
+     * retrato e invalido, a arvore nao e alterada.
+     * @param entrada fluxo de origem, aberto em modo binario
+     * @param serializador le cada chave; deve ser do mesmo tipo usado para salvar
+     * @throws ExcecaoRetratoInvalido se o retrato esta truncado, se a soma de verificacao nao
+     * confere ou se ele foi gravado em outra versao do formato, com outro tamanho de chave ou
+     * com as chaves fora da ordem do comparador
+     */
+    template <typename Serializador = SerializadorTrivial<T>>
+    void carregar(std::istream& entrada, Serializador const& serializador = Serializador())
+    {
+        LeitorDeRetrato leitor{entrada};
+
+        char assinatura[sizeof(retrato::assinatura)];
+        leitor.ler(assinatura, sizeof(assinatura));
+
+        if (std::memcmp(assinatura, retrato::assinatura, sizeof(assinatura)) != 0)
+        {
+            throw ExcecaoRetratoInvalido{"assinatura desconhecida"};
+        }
+
+        if (leitor.lerValor<std::uint32_t>() != retrato::versao)
+        {
+            throw ExcecaoRetratoInvalido{"versao do formato nao suportada"};
+        }
+
+        if (leitor.lerValor<std::uint32_t>() != tamanhoDaChave<Serializador>())
+        {
+            throw ExcecaoRetratoInvalido{"tamanho de chave diferente"};
+        }
+
+        leitor.lerValor<std::uint32_t>();
+        std::uint64_t quantidade_lida = leitor.lerValor<std::uint64_t>();
+
+        if (quantidade_lida > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+        {
+            throw ExcecaoRetratoInvalido{"quantidade de chaves invalida"};
+        }
+
+        std::size_t n = static_cast<std::size_t>(quantidade_lida);
+
+        if constexpr (std::is_same_v<Serializador, SerializadorTrivial<T>>)
+        {
+            /**
+             * leituras de um bloco por vez, direto do fluxo para o vetor: a memoria cresce com
+             * os bytes de fato lidos, e uma quantidade corrompida no cabecalho termina em retrato
+             * truncado, sem reservar antes a memoria de todas as chaves anunciadas
+             */
+            std::vector<T> chaves;
+            std::size_t const chaves_por_bloco = std::max<std::size_t>(1, retrato::tamanhoDoBuffer / sizeof(T));
+
+            while (chaves.size() < n)
+            {
+                std::size_t lidas = chaves.size();
+                std::size_t bloco = std::min(chaves_por_bloco, n - lidas);
+
+                chaves.resize(lidas + bloco);
+                leitor.ler(chaves.data() + lidas, bloco * sizeof(T));
+            }
+
+            leitor.verificarSoma();
+            carregaOrdenadas(chaves.begin(), chaves.end());
+        }
+        else
+        {
+            std::vector<T> chaves;
+            chaves.reserve(std::min(n, retrato::tamanhoDoBuffer));
+
+            for (std::size_t i = 0; i < n; i++)
+            {
+                chaves.push_back(serializador.ler(leitor));
+            }
+
+            leitor.verificarSoma();
+            carregaOrdenadas(chaves.begin(), chaves.end());
+        }
+    }
+
+private:
+    /**
+     * @brief tamanho de cada chave gravado no cabecalho do retrato, ou 0 se as chaves sao
+     * gravadas por um serializador proprio, com tamanho variavel
+     */
+    template <typename Serializador>
+    static constexpr std::uint32_t tamanhoDaChave()
+    {
+        return std::is_same_v<Serializador, SerializadorTrivial<T>> ? sizeof(T) : 0;
+    }
+
+    /**
+     * @brief confere que as chaves lidas de um retrato estao em ordem e as move para uma
+     * arvore balanceada
+     */
+    template <typename Iterador>
+    void carregaOrdenadas(Iterador primeiro, Iterador ultimo)
+    {
+        if (!std::is_sorted(primeiro, ultimo, comparador))
+        {
+            throw ExcecaoRetratoInvalido{"chaves fora de ordem"};
+        }
+
+        construirDeOrdenado(std::make_move_iterator(primeiro), std::make_move_iterator(ultimo));
+    }
+
+public:
+    /**
+     * @brief Insere uma copia de uma chave na arvore
+     * @param chave chave a ser inserida
+     */
+    void inserir(T const& chave)
+    {
+        insere(chave);
+    }
+
+    /**
+     * @brief Insere uma chave na arvore, movendo-a para dentro do nodo
+     * @param chave chave a ser inserida
+     */
+    void inserir(T&& chave)
+    {
+        insere(std::move(chave));
+    }
+
+    /**
+     * @brief Insere uma copia de uma chave a partir de uma dica da sua posicao. A busca sobe
+     * da dica ate o ancestral cuja subarvore contem a posicao da chave e desce dele, com
+     * O(log d) comparacoes, sendo d a distancia em ordem entre a dica e a chave. Para chaves
+     * que chegam em ordem crescente, passar end() ou o iterador retornado pela insercao
+     * anterior custa O(1) comparacoes amortizadas. A dica so afeta o custo, nunca a posicao
+     * em que a chave fica.
+     * @param dica iterador para uma chave proxima de @param chave, ou end() para comecar
+     * pela maior chave
+     * @param chave chave a ser inserida
+     * @return Iterador para a chave inserida
+     */
+    Iterador inserir(Iterador dica, T const& chave)
+    {
+        return insereAPartirDe(dica.nodo, chave);
+    }
+
+    /**
+     * @brief Como inserir(Iterador, T const&), mas move a chave para dentro do nodo
+     */
+    Iterador inserir(Iterador dica, T&& chave)
+    {
+        return insereAPartirDe(dica.nodo, std::move(chave));
+    }
+
+    /**
+     * @brief Insere uma chave construida no proprio nodo, se a arvore ainda nao contem uma
+     * chave equivalente. A busca e a insercao usam uma unica descida, e nada e construido
+     * quando a chave ja esta na arvore.
+     * @param chave chave procurada, comparavel com T pelo comparador
+     * @param argumentos argumentos do construtor da chave inserida, equivalente a @param chave
+     * @return par com o iterador para a chave na arvore e verdade se ela foi inserida
+     */
+    template <typename K, typename... Argumentos>
+    std::pair<Iterador, bool> inserirSeAusente(K const& chave, Argumentos&&... argumentos)
+    {
+        Nodo<T> *pai = nullptr;
+        Nodo<T> *nodo = this->raiz;
+        bool a_esquerda = false;
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+            pai = nodo;
+
+            if (comparador(chave, nodo->chave))
+            {
+                a_esquerda = true;
+                nodo = nodo->filhoEsquerda;
+            }
+            else if (comparador(nodo->chave, chave))
+            {
+                a_esquerda = false;
+                nodo = nodo->filhoDireita;
+            }
+            else
+            {
+                return {Iterador{this, nodo}, false};
+            }
+        }
+
+        Nodo<T> *novo_nodo = criaNodo(std::forward<Argumentos>(argumentos)...);
+        novo_nodo->pai = pai;
+
+        if (pai == nullptr)
+        {
+            this->raiz = novo_nodo;
+            anotaExtremo(novo_nodo);
+            return {Iterador{this, novo_nodo}, true};
+        }
+
+        if (a_esquerda)
+        {
+            pai->filhoEsquerda = novo_nodo;
+        }
+        else
+        {
+            pai->filhoDireita = novo_nodo;
+        }
+
+        anotaExtremo(novo_nodo);
+
+        // so agora se sabe que a insercao ocorre; os tamanhos do caminho sao corrigidos na subida
+        for (Nodo<T> *ancestral = pai; ancestral != nullptr; ancestral = ancestral->pai)
+        {
+            this->registraSubida();
+            ancestral->tamanho++;
+        }
+
+        retracaInsercao(pai);
+        return {Iterador{this, novo_nodo}, true};
+    }
+
+private:
+    /**
+     * @brief insere uma chave, criando o nodo apenas ao chegar a folha, ou, se a arvore conta
+     * repeticoes e ja contem a chave, incrementando a contagem do seu nodo
+     * @param chave chave a ser inserida, copiada ou movida para o novo nodo
+     */
+    template <typename Chave>
+    void insere(Chave&& chave)
+    {
+        if (vazia())
+        {
+            this->raiz = criaNodo(std::forward<Chave>(chave));
+            anotaExtremo(this->raiz);
+            return;
+        }
+
+        /**
+         * desce ate a folha correspondente a chave; como a quantidade de chaves
+         * sempre aumenta, o tamanho de cada subarvore do caminho ja e incrementado
+         */
+        Nodo<T> *pai = nullptr;
+        Nodo<T> *nodo = this->raiz;
+        this->registraBusca();
+
+        while (nodo != nullptr)
+        {
+            this->registraVisita();
+            pai = nodo;
+            pai->tamanho++;
+
+            bool menor = comparador(chave, pai->chave);
+
+            if constexpr (ContaRepeticoes)
+            {
+                if (!menor && !comparador(pai->chave, chave))
+                {
+                    pai->contagem++;
+                    return;
+                }
+            }
+
+            nodo = menor ? pai->filhoEsquerda : pai->filhoDireita;
+        }
+
+        Nodo<T> *novo_nodo = criaNodo(std::forward<Chave>(chave));
+        novo_nodo->pai = pai;
+
+        if (comparador(novo_nodo->chave, pai->chave))
+        {
+            pai->filhoEsquerda = novo_nodo;
+        }
+        else
+        {
+            pai->filhoDireita = novo_nodo;
+        }
+
+        anotaExtremo(novo_nodo);
+        retracaInsercao(pai);
+    };
+
+    /**
+     * @brief insere uma chave comecando a busca por um nodo qualquer da arvore. Sobe pelos
+     * pais ate encontrar um ancestral que limita a posicao da chave pelo lado oposto ao da
+     * subida; so esses ancestrais sao comparados com a chave. Depois desce, como insere, a
+     * partir do mais alto nodo cuja subarvore sabidamente contem a posicao da chave.
+     *
+     * Os tamanhos sao corrigidos no mesmo percurso: a subida incrementa os nodos a partir do
+     * nodo de descida e, quando a descida passa a um ancestral, restaura os nodos abaixo dele,
+     * que nao contem a chave. Assim, anexar a maior chave sobe uma unica vez ate a raiz.
+     * @param inicio nodo de onde a busca parte, ou nullptr para partir do maior nodo
+     * @param chave chave a ser inserida, copiada ou movida para o novo nodo
+     * @return Iterador para o nodo da chave
+     */
+    template <typename Chave>
+    Iterador insereAPartirDe(Nodo<T> *inicio, Chave&& chave)
+    {
+        if (vazia())
+        {
+            this->raiz = criaNodo(std::forward<Chave>(chave));
+            anotaExtremo(this->raiz);
+            return Iterador{this, this->raiz};
+        }
+
+        if (inicio == nullptr)
+        {
+            inicio = this->nodoMaximo;
+        }
+
+        this->registraBusca();
+        this->registraVisita();
+
+        bool maior = !comparador(chave, inicio->chave);
+        Nodo<T> *descida = inicio;
+        Nodo<T> *filho = inicio;
+        inicio->tamanho++;
+
+        /**
+         * subindo por um lado, a subarvore de descida continua limitada pelo outro lado ate o
+         * primeiro ancestral alcancado pelo lado oposto; se a chave passa desse ancestral, a
+         * descida comeca nele, e a subida continua
+         */
+        for (; filho->pai != nullptr; filho = filho->pai)
+        {
+            this->registraSubida();
+            Nodo<T> *pai = filho->pai;
+
+            if ((pai->filhoEsquerda == filho) == maior)
+            {
+                this->registraVisita();
+
+                bool passa = maior ? !comparador(chave, pai->chave) : comparador(chave, pai->chave);
+                bool igual = false;
+
+                if constexpr (ContaRepeticoes)
+                {
+                    // subindo pela direita, o ancestral que limita a chave por baixo pode ser igual a ela
+                    igual = !maior && !passa && !comparador(pai->chave, chave);
+                }
+
+                if (!passa && !igual)
+                {
+                    break;
+                }
+
+                for (; descida != pai; descida = descida->pai)
+                {
+                    descida->tamanho--;
+                }
+
+                if (igual)
+                {
+                    break;
+                }
+            }
+
+            pai->tamanho++;
+        }
+
+        for (Nodo<T> *ancestral = filho->pai; ancestral != nullptr; ancestral = ancestral->pai)
+        {
+            this->registraSubida();
+            ancestral->tamanho++;
+        }
+
+        Nodo<T> *pai = descida;
+        bool menor = false;
+
+        while (true)
+        {
+            menor = comparador(chave, pai->chave);
+
+            if constexpr (ContaRepeticoes)
+            {
+                if (!menor && !comparador(pai->chave, chave))
+                {
+                    pai->contagem++;
+                    return Iterador{this, pai};
+                }
+            }
+
+            Nodo<T> *proximo = menor ? pai->filhoEsquerda : pai->filhoDireita;
+
+            if (proximo == nullptr)
+            {
+                break;
+            }
+
+            this->registraVisita();
+            proximo->tamanho++;
+            pai = proximo;
+        }
+
+        Nodo<T> *novo_nodo = criaNodo(std::forward<Chave>(chave));
+        novo_nodo->pai = pai;
+
+        if (menor)
+        {
+            pai->filhoEsquerda = novo_nodo;
+        }
+        else
+        {
+            pai->filhoDireita = novo_nodo;
+        }
+
+        anotaExtremo(novo_nodo);
+        retracaInsercao(pai);
+        return Iterador{this, novo_nodo};
+    }
+
+    /**
+     * @brief sobe pelo caminho da insercao ajustando alturas, parando quando a altura de uma
+     * subarvore nao muda ou apos a (unica) rotacao que uma insercao pode exigir
+     * @param nodo pai do nodo inserido
+    */
+    void retracaInsercao(Nodo<T> *nodo)
+    {
+        while (nodo != nullptr)
+        {
+            int altura_antiga = nodo->altura;
+            ajustaAltura(nodo);
+
+            int fb_nodo = fatorDeBalanceamento(nodo);
+
+            if (fb_nodo > 1 || fb_nodo < -1)
+            {
+                // a rotacao devolve a subarvore a altura que tinha antes da insercao
+                verificaRotacao(nodo);
+                return;
+            }
+
+            if (nodo->altura == altura_antiga)
+            {
+                return;
+            }
+
+            this->registraSubida();
+            nodo = nodo->pai;
+        }
+    }
+
+    /**
+     * @brief sobe pelo caminho da remocao ajustando alturas e rotacionando ate que a altura de
+     * uma subarvore nao mude; acima desse ponto apenas decrementa o tamanho das subarvores
+     * @param nodo nodo mais profundo cuja subarvore perdeu um nodo
+     * @param removidos contagem do nodo removido, que as subarvores acima perdem
+    */
+    void retracaRemocao(Nodo<T> *nodo, int removidos = 1)
+    {
+        while (nodo != nullptr)
+        {
+            int altura_antiga = nodo->altura;
+            ajustaAltura(nodo);
+
+            Nodo<T> *raiz_subarvore = verificaRotacao(nodo);
+
+            if (raiz_subarvore->altura == altura_antiga)
+            {
+                for (nodo = raiz_subarvore->pai; nodo != nullptr; nodo = nodo->pai)
+                {
+                    this->registraSubida();
+                    nodo->tamanho -= removidos;
+                }
+
+                return;
+            }
+
+            this->registraSubida();
+            nodo = raiz_subarvore->pai;
+        }
+    }
+
+    /**
+     * @brief ajusta a altura e o tamanho da subarvore de um nodo
+     * @param nodo nodo a ter a altura ajustada
+    */
+    void ajustaAltura(Nodo<T> *nodo)
+    {
+        if (nodo != nullptr)
+        {
+            if (nodo->filhoEsquerda && nodo->filhoDireita)
+            {
+
+                nodo->altura = std::max(nodo->filhoEsquerda->altura, nodo->filhoDireita->altura) + 1;
+            }
+            else if (!nodo->filhoEsquerda && nodo->filhoDireita)
+            {
+
+                nodo->altura = std::max(nodo->filhoDireita->altura, -1) + 1;
+            }
+            else if (nodo->filhoEsquerda && !nodo->filhoDireita)
+            {
+
+                nodo->altura = std::max(nodo->filhoEsquerda->altura, -1) + 1;
+            }
+            else
+            {
+
+                nodo->altura = 0;
+            }
+
+            nodo->tamanho = tamanhoDe(nodo->filhoEsquerda) + tamanhoDe(nodo->filhoDireita) + nodo->contagem;
+        }
+    };
+
+    /**
+     * @brief verifica a necessidade de rotacao a partir de um nodo dado
+     * @param nodo nodo o qual se baseara a rotacao
+     * @return raiz da subarvore apos a eventual rotacao
+    */
+    Nodo<T> *verificaRotacao(Nodo<T> *nodo)
+    {
+
+        if (nodo != nullptr)
+        {
+            int fb_nodo = fatorDeBalanceamento(nodo);
+
+            if (fb_nodo > 1)
+            {
+                if (fatorDeBalanceamento(nodo->filhoEsquerda) >= 0)
+                {
+                    this->registraRotacaoSimplesDireita();
+                    rotacaoSimplesDireita(nodo);
+                }
+                else
+                {
+                    this->registraRotacaoEsquerdaDireita();
+                    rotacaoEsquerdaDireita(nodo);
+                }
+            }
+            else if (fb_nodo < -1)
+            {
+                if (fatorDeBalanceamento(nodo->filhoDireita) <= 0)
+                {
+                    this->registraRotacaoSimplesEsquerda();
+                    rotacaoSimplesEsquerda(nodo);
+                }
+                else
+                {
+                    this->registraRotacaoDireitaEsquerda();
+                    rotacaoDireitaEsquerda(nodo);
+                }
+            }
+            else
+            {
+                return nodo;
+            }
+
+            // nodo desceu um nivel; seu pai e a nova raiz da subarvore
+            return nodo->pai;
+        }
+
+        return nodo;
+    };
+
+    /**
+     * @brief verifica o fator de balancamento de um nodo e o retorna
+     * @param nodo
+     * (fator de balanceamento = altura filho esquerda - altura filho direita)
+    */
+    int fatorDeBalanceamento(Nodo<T> *nodo)
+    {
+        if (nodo)
+        {
+            if (nodo->filhoEsquerda && nodo->filhoDireita)
+            {
+
+                return nodo->filhoEsquerda->altura - nodo->filhoDireita->altura;
+            }
+            else if (!nodo->filhoEsquerda && nodo->filhoDireita)
+            {
+
+                return -1 - nodo->filhoDireita->altura;
+            }
+            else if (nodo->filhoEsquerda && !nodo->filhoDireita)
+            {
+
+                return nodo->filhoEsquerda->altura + 1;
+            }
+
+            return 0;
+        }
+        else
+        {
+
+            return 0;
+        }
+    }
+
+    /**
+     * @brief retorna o nodo antecessor
+     * @param nodo nodo referencia
+     * @return nodo antecessor a referencia, ou nullptr se ela e o menor nodo
+     */
+    static Nodo<T> *getAntecessor(Nodo<T> *nodo)
+    {
+        if (nodo->filhoEsquerda != nullptr)
+        {
+            return getMaisDireita(nodo->filhoEsquerda);
+        }
+
+        // sobe enquanto o nodo for filho a esquerda
+        while (nodo->pai != nullptr && nodo->pai->filhoEsquerda == nodo)
+        {
+            nodo = nodo->pai;
+        }
+
+        return nodo->pai;
+    }
+
+    /**
+     * @brief retorna o nodo sucessor
+     * @param nodo nodo referencia
+     * @return nodo sucessor a referencia, ou nullptr se ela e o maior nodo
+     */
+    static Nodo<T> *getSucessor(Nodo<T> *nodo)
+    {
+        if (nodo->filhoDireita != nullptr)
+        {
+            return getMaisEsquerda(nodo->filhoDireita);
+        }
+
+        // sobe enquanto o nodo for filho a direita
+        while (nodo->pai != nullptr && nodo->pai->filhoDireita == nodo)
+        {
+            nodo = nodo->pai;
+        }
+
+        return nodo->pai;
+    }
+
+    /**
+     * @brief procura o nodo mais a direita
+     * @param nodo referencia para inicio da busca, possivelmente nullptr
+     * @return nodo mais a direita
+     */
+    static Nodo<T> *getMaisDireita(Nodo<T> *nodo)
+    {
+        if (nodo != nullptr)
+        {
+            while (nodo->filhoDireita != nullptr)
+            {
+                nodo = nodo->filhoDireita;
+            }
+        }
+
+        return nodo;
+    }
+
+    /**
+     * @brief procura o nodo mais a esquerda
+     * @param nodo referencia para inicio da busca, possivelmente nullptr
+     * @return nodo mais a esquerda
+     */
+    static Nodo<T> *getMaisEsquerda(Nodo<T> *nodo)
+    {
+        if (nodo != nullptr)
+        {
+            while (nodo->filhoEsquerda != nullptr)
+            {
+                nodo = nodo->filhoEsquerda;
+            }
+        }
+
+        return nodo;
+    }
+
+    /**
+     * @brief realiza uma rotação simples à direita
+     * @param nodo_base nodo desbalanceado
+    */
+    void rotacaoSimplesDireita(Nodo<T> *nodo_base)
+    {
+
+        Nodo<T> *filho_esquerda = nodo_base->filhoEsquerda;
+        Nodo<T> *pai_nodo_base = nodo_base->pai;
+
+        nodo_base->filhoEsquerda = filho_esquerda->filhoDireita;
+
+        if (nodo_base->filhoEsquerda != nullptr)
+        {
+            nodo_base->filhoEsquerda->pai = nodo_base;
+        }
+
+        filho_esquerda->filhoDireita = nodo_base;
+        nodo_base->pai = filho_esquerda;
+
+        substituiFilho(pai_nodo_base, nodo_base, filho_esquerda);
+
+        ajustaAltura(nodo_base);
+        ajustaAltura(filho_esquerda);
+    };
+
+    /**
+     * @brief realiza uma rotação simples à esquerda
+     * @param nodo_base nodo desbalanceado
+    */
+    void rotacaoSimplesEsquerda(Nodo<T> *nodo_base)
+    {
+
+        Nodo<T> *filho_direita = nodo_base->filhoDireita;
+        Nodo<T> *pai_nodo_base = nodo_base->pai;
+
+        nodo_base->filhoDireita = filho_direita->filhoEsquerda;
+
+        if (nodo_base->filhoDireita != nullptr)
+        {
+            nodo_base->filhoDireita->pai = nodo_base;
+        }
+
+        filho_direita->filhoEsquerda = nodo_base;
+        nodo_base->pai = filho_direita;
+
+        substituiFilho(pai_nodo_base, nodo_base, filho_direita);
+
+        ajustaAltura(nodo_base);
+        ajustaAltura(filho_direita);
+    };
+
+    /**
+     * @brief realiza uma rotação direta-esquerda
+     * @param nodo_base nodo desbalanceado
+    */
+    void rotacaoDireitaEsquerda(Nodo<T> *nodo_base)
+    {
+        rotacaoSimplesDireita(nodo_base->filhoDireita);
+        rotacaoSimplesEsquerda(nodo_base);
+    };
+
+    /**
+     * @brief realiza uma rotação esquerda-direita
+     * @param nodo_base nodo desbalanceado
+    */
+    void rotacaoEsquerdaDireita(Nodo<T> *nodo_base)
+    {
+        rotacaoSimplesEsquerda(nodo_base->filhoEsquerda);
+        rotacaoSimplesDireita(nodo_base);
+    };
+
+public:
+    /**
+     * @brief Remove uma chave da arvore
+     * @param chave chave a ser removida
+     * @return Verdade se uma chave foi removida
+     */
+    bool remover(T const& chave)
+    {
+        Nodo<T> *nodo = procuraChave(chave, this->raiz);
+
+        if (nodo == nullptr)
+        {
+            return false;
+        }
+
+        removeNodo(nodo);
+        return true;
+    };
+
+    /**
+     * @brief Remove uma chave equivalente a uma chave de outro tipo; disponivel apenas com
+     * comparador transparente
+     * @param chave chave a ser removida
+     * @return Verdade se uma chave foi removida
+     */
+    template <typename K, typename C = Comparador, typename = typename C::is_transparent>
+    bool remover(K const& chave)
+    {
+        Nodo<T> *nodo = procuraChave(chave, this->raiz);
+
+        if (nodo == nullptr)
+        {
+            return false;
+        }
+
+        removeNodo(nodo);
+        return true;
+    }
+
+private:
+    /**
+     * @brief remove uma repeticao da chave de um nodo; o nodo so e desligado e liberado
+     * quando era a ultima
+     */
+    void removeNodo(Nodo<T> *nodo)
+    {
+        if constexpr (ContaRepeticoes)
+        {
+            if (nodo->contagem > 1)
+            {
+                nodo->contagem--;
+
+                for (; nodo != nullptr; nodo = nodo->pai)
+                {
+                    this->registraSubida();
+                    nodo->tamanho--;
+                }
+
+                return;
+            }
+        }
+
+        removeTodas(nodo);
+    }
+
+    /**
+     * @brief desliga e libera um nodo, com todas as repeticoes da sua chave
+     */
+    void removeTodas(Nodo<T> *nodo)
+    {
+        // a menor chave tem no maximo uma folha a direita, de modo que seu sucessor e essa folha ou o pai
+        if (nodo == this->nodoMinimo)
+        {
+            this->nodoMinimo = getSucessor(nodo);
+        }
+
+        if (nodo == this->nodoMaximo)
+        {
+            this->nodoMaximo = getAntecessor(nodo);
+        }
+
+        retracaRemocao(desencadeia(nodo), nodo->contagem);
+        destroiNodo(nodo);
+    }
+
+    /**
+     * @brief acrescenta repeticoes a chave de um nodo, corrigindo os tamanhos ate a raiz
+     */
+    void somaContagem(Nodo<T> *nodo, int repeticoes)
+    {
+        nodo->contagem += repeticoes;
+
+        for (; nodo != nullptr; nodo = nodo->pai)
+        {
+            this->registraSubida();
+            nodo->tamanho += repeticoes;
+        }
+    }
+
+public:
+
+    /**
+     * @brief Junta a esta arvore uma chave e outra arvore cujas chaves sao todas maiores, em
+     * O(log n). A outra arvore fica vazia. Se a arvore conta repeticoes, chaves iguais nas
+     * divisas ficam em um unico nodo, com as contagens somadas.
+     * @param chave chave maior ou igual a todas as chaves desta arvore e menor ou igual a
+     * todas as chaves de @param direita
+     * @param direita arvore cujas chaves serao movidas para o fim desta; juntar a arvore a ela
+     * mesma nao tem efeito
+     */
+    void juntar(T chave, ArvoreAVL& direita)
+    {
+        if (&direita == this)
+        {
+            return;
+        }
+
+        if constexpr (ContaRepeticoes)
+        {
+            // a chave do meio pode ser igual a maior chave desta arvore ou a menor da outra
+            Nodo<T> *igual = nullptr;
+
+            if (!vazia() && !comparador(this->nodoMaximo->chave, chave))
+            {
+                igual = this->nodoMaximo;
+            }
+            else if (!direita.vazia() && !comparador(chave, direita.nodoMinimo->chave))
+            {
+                igual = direita.nodoMinimo;
+            }
+
+            if (igual != nullptr)
+            {
+                somaContagem(igual, 1);
+                juntar(direita);
+                return;
+            }
+        }
+
+        adotaNodos(direita);
+
+        Nodo<T> *meio = criaNodo(std::move(chave));
+
+        this->raiz = juntarNodos(this->raiz, meio, direita.raiz);
+        direita.raiz = nullptr;
+        atualizaExtremos();
+        direita.atualizaExtremos();
+    }
+
+    /**
+     * @brief Junta a esta arvore outra arvore cujas chaves sao todas maiores ou iguais, em
+     * O(log n). A outra arvore fica vazia. Se a arvore conta repeticoes e a maior chave desta
+     * e igual a menor da outra, elas ficam em um unico nodo, com as contagens somadas.
+     * @param direita arvore cujas chaves serao movidas para o fim desta
+     */
+    void juntar(ArvoreAVL& direita)
+    {
+        if (&direita == this || direita.vazia())
+        {
+            return;
+        }
+
+        if constexpr (ContaRepeticoes)
+        {
+            if (!vazia() && !comparador(this->nodoMaximo->chave, direita.nodoMinimo->chave))
+            {
+                somaContagem(this->nodoMaximo, direita.nodoMinimo->contagem);
+                direita.removeTodas(direita.nodoMinimo);
+
+                if (direita.vazia())
+                {
+                    return;
+                }
+            }
+        }
+
+        adotaNodos(direita);
+
+        // a menor chave da outra arvore e desligada e reaproveitada como a chave do meio
+        Nodo<T> *meio = getMaisEsquerda(direita.raiz);
+        direita.retracaRemocao(direita.desencadeia(meio), meio->contagem);
+
+        meio->filhoEsquerda = nullptr;
+        meio->filhoDireita = nullptr;
+
+        this->raiz = juntarNodos(this->raiz, meio, direita.raiz);
+        direita.raiz = nullptr;
+        atualizaExtremos();
+        direita.atualizaExtremos();
+    }
+
+    /**
+     * @brief Divide a arvore em O(log n): as chaves menores que uma chave permanecem nesta
+     * arvore e as demais sao movidas para a arvore retornada, que compartilha o alocador
+     * desta
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return arvore com as chaves maiores ou iguais a @param chave
+     */
+    ArvoreAVL dividir(T const& chave)
+    {
+        ArvoreAVL direita{alocador, comparador};
+
+        std::pair<Nodo<T> *, Nodo<T> *> partes = dividirRec(this->raiz, chave);
+
+        this->raiz = partes.first;
+        direita.raiz = partes.second;
+        atualizaExtremos();
+        direita.atualizaExtremos();
+
+        return direita;
+    }
+
+    /**
+     * @brief Torna esta arvore a uniao dela com outra, em O(m log(n/m + 1)), dividindo o
+     * trabalho entre as threads de um pool. As chaves da outra arvore sao movidas para esta e
+     * a outra arvore fica vazia. Sem contagem de repeticoes, cada arvore deve ter chaves
+     * distintas; com contagem, as contagens das chaves iguais sao somadas.
+     * @param outra arvore cujas chaves serao unidas a esta
+     * @param pool threads que executam as subarvores independentes em paralelo
+     */
+    void unir(ArvoreAVL& outra, PoolDeThreads& pool = PoolDeThreads::padrao())
+    {
+        operacaoDeConjunto(outra, pool, [this](Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& p) {
+            return uniaoRec(a, b, descartados, p);
+        });
+    }
+
+    /**
+     * @brief Mantem nesta arvore apenas as chaves que tambem estao em outra, em
+     * O(m log(n/m + 1)), dividindo o trabalho entre as threads de um pool. A outra arvore
+     * fica vazia. Sem contagem de repeticoes, cada arvore deve ter chaves distintas; com
+     * contagem, cada chave fica com a menor das suas contagens nas duas arvores.
+     * @param outra arvore com as chaves a serem mantidas
+     * @param pool threads que executam as subarvores independentes em paralelo
+     */
+    void intersectar(ArvoreAVL& outra, PoolDeThreads& pool = PoolDeThreads::padrao())
+    {
+        operacaoDeConjunto(outra, pool, [this](Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& p) {
+            return intersecaoRec(a, b, descartados, p);
+        });
+    }
+
+    /**
+     * @brief Remove desta arvore as chaves que estao em outra, em O(m log(n/m + 1)),
+     * dividindo o trabalho entre as threads de um pool. A outra arvore fica vazia. Sem
+     * contagem de repeticoes, cada arvore deve ter chaves distintas; com contagem, a contagem
+     * de cada chave na outra arvore e descontada da sua contagem nesta.
+     * @param outra arvore com as chaves a serem removidas
+     * @param pool threads que executam as subarvores independentes em paralelo
+     */
+    void subtrair(ArvoreAVL& outra, PoolDeThreads& pool = PoolDeThreads::padrao())
+    {
+        operacaoDeConjunto(outra, pool, [this](Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& p) {
+            return diferencaRec(a, b, descartados, p);
+        });
+    }
+
+private:
+    /**
+     * @brief desliga um nodo da arvore; se ele tem dois filhos, seu sucessor e religado em seu
+     * lugar, de modo que nenhuma chave e copiada e os demais nodos continuam validos
+     * @param nodo nodo a ser desligado
+     * @return nodo mais profundo cuja subarvore perdeu um nodo, a partir do qual a arvore
+     * deve ser rebalanceada
+    */
+    Nodo<T> *desencadeia(Nodo<T> *nodo)
+    {
+        if (nodo->filhoEsquerda == nullptr || nodo->filhoDireita == nullptr)
+        {
+            // filho unico ou nullptr, se o nodo e uma folha
+            Nodo<T> *filho = (nodo->filhoEsquerda != nullptr) ? nodo->filhoEsquerda : nodo->filhoDireita;
+            Nodo<T> *pai = nodo->pai;
+
+            substituiFilho(pai, nodo, filho);
+            return pai;
+        }
+
+        Nodo<T> *sucessor = nodo->filhoDireita;
+
+        while (sucessor->filhoEsquerda != nullptr)
+        {
+            sucessor = sucessor->filhoEsquerda;
+        }
+
+        Nodo<T> *inicio = sucessor;
+
+        if (sucessor != nodo->filhoDireita)
+        {
+            /**
+             * o sucessor sai de sua posicao, deixando em seu lugar o seu filho
+             * a direita, e herda a subarvore a direita do nodo removido
+             */
+            inicio = sucessor->pai;
+
+            if constexpr (ContaRepeticoes)
+            {
+                /**
+                 * o caminho ate o sucessor perde a contagem dele, e nao a do nodo removido,
+                 * que e a descontada das subarvores acima do ponto em que o rebalanceamento para
+                 */
+                for (Nodo<T> *ancestral = inicio; ancestral != nodo; ancestral = ancestral->pai)
+                {
+                    ancestral->tamanho -= sucessor->contagem - nodo->contagem;
+                }
+            }
+
+            substituiFilho(inicio, sucessor, sucessor->filhoDireita);
+
+            sucessor->filhoDireita = nodo->filhoDireita;
+            sucessor->filhoDireita->pai = sucessor;
+        }
+
+        sucessor->filhoEsquerda = nodo->filhoEsquerda;
+        sucessor->filhoEsquerda->pai = sucessor;
+        substituiFilho(nodo->pai, nodo, sucessor);
+
+        // o sucessor assume a altura e o tamanho antigos do nodo, para que o rebalanceamento os compare
+        sucessor->altura = nodo->altura;
+        sucessor->tamanho = nodo->tamanho;
+
+        return inicio;
+    }
+
+    /**
+     * @brief garante que os nodos de outra arvore possam ser liberados pelo alocador desta,
+     * absorvendo os blocos do outro alocador ou, se ele e compartilhado, recriando os nodos
+     * @param outra arvore cujos nodos serao movidos para esta
+     */
+    void adotaNodos(ArvoreAVL& outra)
+    {
+        if (!alocador.absorver(outra.alocador))
+        {
+            outra.raiz = copiaSubarvore(outra.raiz, outra.alocador);
+        }
+    }
+
+    /**
+     * @brief recria com o alocador desta arvore os nodos de uma subarvore criada por outro
+     * alocador, liberando os nodos originais
+     * @param nodo raiz da subarvore original
+     * @param origem alocador que criou a subarvore original
+     * @return raiz da nova subarvore
+     */
+    Nodo<T> *copiaSubarvore(Nodo<T> *nodo, Alocador<Nodo<T>>& origem)
+    {
+        if (nodo == nullptr)
+        {
+            return nullptr;
+        }
+
+        Nodo<T> *copia = criaNodo(std::move(nodo->chave));
+        copia->altura = nodo->altura;
+        copia->tamanho = nodo->tamanho;
+
+        if constexpr (ContaRepeticoes)
+        {
+            copia->contagem = nodo->contagem;
+        }
+
+        copia->filhoEsquerda = copiaSubarvore(nodo->filhoEsquerda, origem);
+        copia->filhoDireita = copiaSubarvore(nodo->filhoDireita, origem);
+
+        if (copia->filhoEsquerda != nullptr)
+        {
+            copia->filhoEsquerda->pai = copia;
+        }
+
+        if (copia->filhoDireita != nullptr)
+        {
+            copia->filhoDireita->pai = copia;
+        }
+
+        origem.destruir(nodo);
+        this->registraLiberacoes(1);
+        return copia;
+    }
+
+    /**
+     * @brief junta duas subarvores e um nodo cuja chave fica entre as delas. O nodo e ligado
+     * ao longo da borda da subarvore mais alta, na altura da mais baixa, e o caminho ate a
+     * raiz e rebalanceado pelas rotacoes usuais
+     * @param esquerda raiz da subarvore com as chaves menores, possivelmente nullptr
+     * @param meio nodo sem filhos que ligara as duas subarvores
+     * @param direita raiz da subarvore com as chaves maiores, possivelmente nullptr
+     * @return raiz da subarvore resultante
+     */
+    Nodo<T> *juntarNodos(Nodo<T> *esquerda, Nodo<T> *meio, Nodo<T> *direita)
+    {
+        int altura_esquerda = alturaDe(esquerda);
+        int altura_direita = alturaDe(direita);
+        Nodo<T> *pai = nullptr;
+        bool pela_direita = false;
+
+        if (altura_esquerda > altura_direita + 1)
+        {
+            // desce pela borda direita da subarvore esquerda
+            pela_direita = true;
+
+            while (alturaDe(esquerda) > altura_direita + 1)
+            {
+                pai = esquerda;
+                esquerda = esquerda->filhoDireita;
+            }
+        }
+        else if (altura_direita > altura_esquerda + 1)
+        {
+            // desce pela borda esquerda da subarvore direita
+            while (alturaDe(direita) > altura_esquerda + 1)
+            {
+                pai = direita;
+                direita = direita->filhoEsquerda;
+            }
+        }
+
+        meio->filhoEsquerda = esquerda;
+        meio->filhoDireita = direita;
+        meio->pai = pai;
+
+        if (esquerda != nullptr)
+        {
+            esquerda->pai = meio;
+        }
+
+        if (direita != nullptr)
+        {
+            direita->pai = meio;
+        }
+
+        if (pai != nullptr)
+        {
+            if (pela_direita)
+            {
+                pai->filhoDireita = meio;
+            }
+            else
+            {
+                pai->filhoEsquerda = meio;
+            }
+        }
+
+        ajustaAltura(meio);
+
+        // sobe ate a raiz ajustando alturas e tamanhos e rotacionando quando necessario
+        Nodo<T> *nodo = meio;
+
+        while (pai != nullptr)
+        {
+            ajustaAltura(pai);
+            nodo = verificaRotacao(pai);
+            pai = nodo->pai;
+        }
+
+        return nodo;
+    }
+
+    /**
+     * @brief divide recursivamente uma subarvore pela chave dada, juntando as partes de cada
+     * lado do caminho de busca
+     * @param nodo raiz da subarvore, possivelmente nullptr
+     * @param chave chave de referencia
+     * @return par com as raizes das subarvores com as chaves menores e com as chaves maiores
+     * ou iguais a @param chave
+     */
+    std::pair<Nodo<T> *, Nodo<T> *> dividirRec(Nodo<T> *nodo, T const& chave)
+    {
+        if (nodo == nullptr)
+        {
+            return {nullptr, nullptr};
+        }
+
+        Nodo<T> *esquerda = desligaFilho(nodo->filhoEsquerda);
+        Nodo<T> *direita = desligaFilho(nodo->filhoDireita);
+        nodo->filhoEsquerda = nullptr;
+        nodo->filhoDireita = nullptr;
+        nodo->pai = nullptr;
+
+        if (!comparador(nodo->chave, chave))
+        {
+            // o nodo e sua subarvore a direita ficam do lado maior
+            std::pair<Nodo<T> *, Nodo<T> *> partes = dividirRec(esquerda, chave);
+            return {partes.first, juntarNodos(partes.second, nodo, direita)};
+        }
+        else
+        {
+            std::pair<Nodo<T> *, Nodo<T> *> partes = dividirRec(direita, chave);
+            return {juntarNodos(esquerda, nodo, partes.first), partes.second};
+        }
+    }
+
+    /**
+     * @brief desliga um nodo de seu pai, tornando-o raiz de uma subarvore independente
+     * @param nodo nodo a ser desligado, possivelmente nullptr
+     * @return o proprio @param nodo
+     */
+    static Nodo<T> *desligaFilho(Nodo<T> *nodo)
+    {
+        if (nodo != nullptr)
+        {
+            nodo->pai = nullptr;
+        }
+
+        return nodo;
+    }
+
+    /**
+     * @brief partes de uma subarvore dividida por uma chave
+     */
+    struct Divisao
+    {
+        Nodo<T> *menores;
+        Nodo<T> *igual;
+        Nodo<T> *maiores;
+    };
+
+    /**
+     * @brief subarvores com menos nodos que isto, somadas, sao processadas sem criar tarefas
+     */
+    static constexpr int limiteParalelo = 4096;
+
+    /**
+     * @brief executa uma operacao de conjunto sobre as raizes das duas arvores e libera, ao
+     * final e em uma unica thread, os nodos descartados pela operacao
+     * @param outra segunda arvore da operacao, que fica vazia
+     * @param pool threads usadas pela operacao
+     * @param operacao funcao que recebe as duas raizes e retorna a raiz do resultado
+     */
+    template <typename Operacao>
+    void operacaoDeConjunto(ArvoreAVL& outra, PoolDeThreads& pool, Operacao operacao)
+    {
+        if (&outra == this)
+        {
+            return;
+        }
+
+        adotaNodos(outra);
+
+        Nodo<T> *a = this->raiz;
+        Nodo<T> *b = outra.raiz;
+
+        // durante a operacao nenhuma rotacao pode alterar a raiz das arvores
+        this->raiz = nullptr;
+        outra.raiz = nullptr;
+
+        std::atomic<Nodo<T> *> descartados{nullptr};
+        Nodo<T> *resultado = operacao(a, b, descartados, pool);
+
+        if (resultado != nullptr)
+        {
+            resultado->pai = nullptr;
+        }
+
+        this->raiz = resultado;
+        atualizaExtremos();
+        outra.atualizaExtremos();
+
+        Nodo<T> *nodo = descartados.load(std::memory_order_acquire);
+
+        while (nodo != nullptr)
+        {
+            Nodo<T> *proximo = nodo->pai;
+            destrutor(nodo);
+            nodo = proximo;
+        }
+    }
+
+    /**
+     * @brief guarda uma subarvore descartada para ser liberada ao final da operacao. Pode ser
+     * chamada por varias threads; os descartados sao encadeados pelo ponteiro para o pai
+     * @param nodo raiz da subarvore descartada, possivelmente nullptr
+     * @param descartados lista de subarvores descartadas
+     */
+    static void descarta(Nodo<T> *nodo, std::atomic<Nodo<T> *>& descartados)
+    {
+        if (nodo != nullptr)
+        {
+            nodo->pai = descartados.load(std::memory_order_relaxed);
+
+            while (!descartados.compare_exchange_weak(nodo->pai, nodo, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    /**
+     * @brief executa duas funcoes, em paralelo se a subarvore e grande o bastante
+     */
+    template <typename F, typename G>
+    static void executa(bool paralelo, PoolDeThreads& pool, F&& primeira, G&& segunda)
+    {
+        if (paralelo)
+        {
+            pool.emParalelo(primeira, segunda);
+        }
+        else
+        {
+            primeira();
+            segunda();
+        }
+    }
+
+    /**
+     * @brief desliga a raiz de uma subarvore de seus filhos
+     * @param nodo raiz da subarvore
+     * @return par com as subarvores a esquerda e a direita, agora independentes
+     */
+    static std::pair<Nodo<T> *, Nodo<T> *> separaFilhos(Nodo<T> *nodo)
+    {
+        std::pair<Nodo<T> *, Nodo<T> *> filhos{desligaFilho(nodo->filhoEsquerda), desligaFilho(nodo->filhoDireita)};
+
+        nodo->filhoEsquerda = nullptr;
+        nodo->filhoDireita = nullptr;
+        nodo->pai = nullptr;
+
+        return filhos;
+    }
+
+    /**
+     * @brief divide uma subarvore em chaves menores, um nodo com chave igual e chaves maiores
+     * @param nodo raiz da subarvore, possivelmente nullptr
+     * @param chave chave de referencia
+     * @return as tres partes; igual e nullptr se a chave nao esta na subarvore
+     */
+    Divisao dividirPorChave(Nodo<T> *nodo, T const& chave)
+    {
+        if (nodo == nullptr)
+        {
+            return {nullptr, nullptr, nullptr};
+        }
+
+        std::pair<Nodo<T> *, Nodo<T> *> filhos = separaFilhos(nodo);
+
+        if (comparador(chave, nodo->chave))
+        {
+            Divisao partes = dividirPorChave(filhos.first, chave);
+            return {partes.menores, partes.igual, juntarNodos(partes.maiores, nodo, filhos.second)};
+        }
+
+        if (comparador(nodo->chave, chave))
+        {
+            Divisao partes = dividirPorChave(filhos.second, chave);
+            return {juntarNodos(filhos.first, nodo, partes.menores), partes.igual, partes.maiores};
+        }
+
+        return {filhos.first, nodo, filhos.second};
+    }
+
+    /**
+     * @brief remove o menor nodo de uma subarvore, rebalanceando-a
+     * @param nodo raiz da subarvore
+     * @return par com a nova raiz da subarvore e o nodo removido, sem filhos
+     */
+    std::pair<Nodo<T> *, Nodo<T> *> removeMinimo(Nodo<T> *nodo)
+    {
+        if (nodo->filhoEsquerda == nullptr)
+        {
+            Nodo<T> *direita = desligaFilho(nodo->filhoDireita);
+            nodo->filhoDireita = nullptr;
+
+            return {direita, nodo};
+        }
+
+        std::pair<Nodo<T> *, Nodo<T> *> resultado = removeMinimo(nodo->filhoEsquerda);
+
+        nodo->filhoEsquerda = resultado.first;
+
+        if (resultado.first != nullptr)
+        {
+            resultado.first->pai = nodo;
+        }
+
+        ajustaAltura(nodo);
+        return {verificaRotacao(nodo), resultado.second};
+    }
+
+    /**
+     * @brief junta duas subarvores sem chave do meio, usando o menor nodo da direita
+     */
+    Nodo<T> *juntarSemMeio(Nodo<T> *esquerda, Nodo<T> *direita)
+    {
+        if (esquerda == nullptr)
+        {
+            return direita;
+        }
+
+        if (direita == nullptr)
+        {
+            return esquerda;
+        }
+
+        std::pair<Nodo<T> *, Nodo<T> *> resultado = removeMinimo(direita);
+        return juntarNodos(esquerda, resultado.second, resultado.first);
+    }
+
+    /**
+     * @brief une duas subarvores: divide a segunda pela raiz da primeira e une as partes de
+     * cada lado, em paralelo se forem grandes
+     */
+    Nodo<T> *uniaoRec(Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& pool)
+    {
+        if (a == nullptr)
+        {
+            return b;
+        }
+
+        if (b == nullptr)
+        {
+            return a;
+        }
+
+        bool paralelo = a->tamanho + b->tamanho >= limiteParalelo;
+
+        std::pair<Nodo<T> *, Nodo<T> *> filhos = separaFilhos(a);
+        Divisao partes = dividirPorChave(b, a->chave);
+
+        if constexpr (ContaRepeticoes)
+        {
+            if (partes.igual != nullptr)
+            {
+                a->contagem += partes.igual->contagem;
+            }
+        }
+
+        descarta(partes.igual, descartados);
+
+        Nodo<T> *esquerda;
+        Nodo<T> *direita;
+
+        executa(paralelo, pool,
+                [&] { esquerda = uniaoRec(filhos.first, partes.menores, descartados, pool); },
+                [&] { direita = uniaoRec(filhos.second, partes.maiores, descartados, pool); });
+
+        return juntarNodos(esquerda, a, direita);
+    }
+
+    /**
+     * @brief intercala duas subarvores mantendo todas as chaves de ambas, inclusive as
+     * repetidas: divide a segunda entre as chaves menores e as maiores ou iguais a raiz da
+     * primeira e intercala as partes de cada lado, em paralelo se forem grandes. Se a arvore
+     * conta repeticoes, chaves iguais ficam em um unico nodo, e a intercalacao e a uniao.
+     */
+    Nodo<T> *intercalaRec(Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& pool)
+    {
+        if constexpr (ContaRepeticoes)
+        {
+            return uniaoRec(a, b, descartados, pool);
+        }
+
+        if (a == nullptr)
+        {
+            return b;
+        }
+
+        if (b == nullptr)
+        {
+            return a;
+        }
+
+        bool paralelo = a->tamanho + b->tamanho >= limiteParalelo;
+
+        std::pair<Nodo<T> *, Nodo<T> *> filhos = separaFilhos(a);
+        std::pair<Nodo<T> *, Nodo<T> *> partes = dividirRec(b, a->chave);
+
+        Nodo<T> *esquerda;
+        Nodo<T> *direita;
+
+        executa(paralelo, pool,
+                [&] { esquerda = intercalaRec(filhos.first, partes.first, descartados, pool); },
+                [&] { direita = intercalaRec(filhos.second, partes.second, descartados, pool); });
+
+        return juntarNodos(esquerda, a, direita);
+    }
+
+    /**
+     * @brief intersecta duas subarvores: divide a segunda pela raiz da primeira e intersecta
+     * as partes de cada lado, em paralelo se forem grandes
+     */
+    Nodo<T> *intersecaoRec(Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& pool)
+    {
+        if (a == nullptr || b == nullptr)
+        {
+            descarta(a, descartados);
+            descarta(b, descartados);
+            return nullptr;
+        }
+
+        bool paralelo = a->tamanho + b->tamanho >= limiteParalelo;
+
+        std::pair<Nodo<T> *, Nodo<T> *> filhos = separaFilhos(a);
+        Divisao partes = dividirPorChave(b, a->chave);
+
+        Nodo<T> *esquerda;
+        Nodo<T> *direita;
+
+        executa(paralelo, pool,
+                [&] { esquerda = intersecaoRec(filhos.first, partes.menores, descartados, pool); },
+                [&] { direita = intersecaoRec(filhos.second, partes.maiores, descartados, pool); });
+
+        if (partes.igual != nullptr)
+        {
+            if constexpr (ContaRepeticoes)
+            {
+                a->contagem = std::min(a->contagem, partes.igual->contagem);
+            }
+
+            descarta(partes.igual, descartados);
+            return juntarNodos(esquerda, a, direita);
+        }
+
+        descarta(a, descartados);
+        return juntarSemMeio(esquerda, direita);
+    }
+
+    /**
+     * @brief subtrai uma subarvore de outra: divide a segunda pela raiz da primeira e subtrai
+     * as partes de cada lado, em paralelo se forem grandes
+     */
+    Nodo<T> *diferencaRec(Nodo<T> *a, Nodo<T> *b, std::atomic<Nodo<T> *>& descartados, PoolDeThreads& pool)
+    {
+        if (a == nullptr || b == nullptr)
+        {
+            descarta(b, descartados);
+            return a;
+        }
+
+        bool paralelo = a->tamanho + b->tamanho >= limiteParalelo;
+
+        std::pair<Nodo<T> *, Nodo<T> *> filhos = separaFilhos(a);
+        Divisao partes = dividirPorChave(b, a->chave);
+
+        Nodo<T> *esquerda;
+        Nodo<T> *direita;
+
+        executa(paralelo, pool,
+                [&] { esquerda = diferencaRec(filhos.first, partes.menores, descartados, pool); },
+                [&] { direita = diferencaRec(filhos.second, partes.maiores, descartados, pool); });
+
+        if (partes.igual != nullptr)
+        {
+            bool restam = false;
+
+            if constexpr (ContaRepeticoes)
+            {
+                a->contagem -= partes.igual->contagem;
+                restam = a->contagem > 0;
+            }
+
+            descarta(partes.igual, descartados);
+
+            if (!restam)
+            {
+                descarta(a, descartados);
+                return juntarSemMeio(esquerda, direita);
+            }
+        }
+
+        return juntarNodos(esquerda, a, direita);
+    }
+
+public:
+    /**
+     * @brief Busca a chave do filho a esquerda de uma (sub)arvore
+     * @param chave chave da arvore que eh pai do filho a esquerda
+     * @return Chave do filho a esquerda. Se chave nao esta na arvore, retorna std::nullopt
+     */
+    std::optional<T> filhoEsquerdaDe(T const& chave) const
+    {
+        if (!vazia())
+        {
+            Nodo<T> *nodo = procuraChave(chave, this->raiz);
+
+            if (nodo != nullptr)
+            {
+                if (nodo->filhoEsquerda != nullptr)
+                {
+
+                    return nodo->filhoEsquerda->chave;
+                }
+                else
+                {
+
+                    return std::nullopt;
+                }
+            }
+        }
+
+        return std::nullopt;
+    };
+
+    /**
+     * @brief Busca a chave do filho a direita de uma (sub)arvore
+     * @param chave chave da arvore que eh pai do filho a direita
+     * @return Chave do filho a direita. Se chave nao esta na arvore, retorna nullptr
+     */
+    std::optional<T> filhoDireitaDe(T const& chave) const
+    {
+        if (!vazia())
+        {
+            Nodo<T> *nodo = procuraChave(chave, this->raiz);
+
+            if (nodo != nullptr)
+            {
+
+                if (nodo->filhoDireita != nullptr)
+                {
+
+                    return nodo->filhoDireita->chave;
+                }
+            }
+        }
+
+        return std::nullopt;
+    };
+
+    /**
+     * @brief Retorna os contadores de operacoes da arvore; disponivel apenas com
+     * ColetaEstatisticas. Com estatisticas, ate as consultas alteram contadores, que sao
+     * atomicos para que as operacoes de conjunto em paralelo possam conta-las.
+     * @return Copia dos contadores
+     */
+    EstatisticasAVL estatisticas() const
+    {
+        static_assert(ColetaEstatisticas, "a arvore nao coleta estatisticas; use ColetaEstatisticas = true");
+
+        EstatisticasAVL resultado = this->lidos();
+        resultado.comparacoes = comparador.comparacoes.lido();
+        return resultado;
+    }
+
+    /**
+     * @brief Zera os contadores de operacoes da arvore; disponivel apenas com
+     * ColetaEstatisticas
+     */
+    void zerarEstatisticas()
+    {
+        static_assert(ColetaEstatisticas, "a arvore nao coleta estatisticas; use ColetaEstatisticas = true");
+
+        static_cast<ContadoresDaArvore<ColetaEstatisticas>&>(*this) = ContadoresDaArvore<ColetaEstatisticas>{};
+        comparador.comparacoes = ContadorDeEventos{};
+    }
+
+    /**
+     * @brief Conta os nodos em cada profundidade da arvore, percorrendo-a; nao depende de
+     * ColetaEstatisticas
+     * @return Vetor em que a posicao d e a quantidade de nodos na profundidade d (a raiz esta
+     * na profundidade 0); vazio se a arvore esta vazia
+     */
+    std::vector<int> histogramaDeProfundidades() const
+    {
+        std::vector<int> histograma(static_cast<std::size_t>(alturaDe(this->raiz) + 1), 0);
+        contaProfundidades(this->raiz, 0, histograma);
+        return histograma;
+    }
+
+    /**
+     * @brief Calcula a quantidade media de nodos visitados por uma busca bem sucedida, supondo
+     * todas as chaves igualmente procuradas, a partir do histograma de profundidades
+     * @return Media de (profundidade + 1) sobre os nodos, ou 0 se a arvore esta vazia
+     */
+    double comprimentoMedioDoCaminho() const
+    {
+        std::vector<int> histograma = histogramaDeProfundidades();
+        long long nodos = 0;
+        long long soma = 0;
+
+        for (std::size_t profundidade = 0; profundidade < histograma.size(); profundidade++)
+        {
+            nodos += histograma[profundidade];
+            soma += static_cast<long long>(profundidade + 1) * histograma[profundidade];
+        }
+
+        return (nodos > 0) ? static_cast<double>(soma) / static_cast<double>(nodos) : 0.0;
+    }
+
+private:
+    /**
+     * @brief trabalha em conjunto com a função histogramaDeProfundidades()
+     */
+    static void contaProfundidades(Nodo<T> *nodo, int profundidade, std::vector<int>& histograma)
+    {
+        if (nodo != nullptr)
+        {
+            histograma[static_cast<std::size_t>(profundidade)]++;
+            contaProfundidades(nodo->filhoEsquerda, profundidade + 1, histograma);
+            contaProfundidades(nodo->filhoDireita, profundidade + 1, histograma);
+        }
+    }
+
+public:
+    /**
+     * @brief Lista chaves visitando a arvore em ordem. Aloca a lista e um elemento por chave;
+     * para apenas percorrer as chaves, use visitarEmOrdem.
+     * @return Lista encadeada contendo as chaves em ordem.
+     */
+    ListaEncadeadaAbstrata<T> *emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T> *lista = new MinhaListaEncadeada<T>;
+        visitarEmOrdem([lista](T const& chave) { lista->inserirNoFim(chave); });
+        return lista;
+    };
+
+    /**
+     * @brief Lista chaves visitando a arvore em pre-ordem
+     * @return Lista encadeada contendo as chaves em pre-ordem.
+     */
+    ListaEncadeadaAbstrata<T> *preOrdem() const
+    {
+        ListaEncadeadaAbstrata<T> *lista = new MinhaListaEncadeada<T>;
+        visitarPreOrdem([lista](T const& chave) { lista->inserirNoFim(chave); });
+        return lista;
+    };
+
+    /**
+     * @brief Lista chaves visitando a arvore em pos-ordem
+     * @return Lista encadeada contendo as chaves em pos ordem.
+     */
+    ListaEncadeadaAbstrata<T> *posOrdem() const
+    {
+        ListaEncadeadaAbstrata<T> *lista = new MinhaListaEncadeada<T>;
+        visitarPosOrdem([lista](T const& chave) { lista->inserirNoFim(chave); });
+        return lista;
+    };
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,620 @@
+#ifndef ARVORE_AVL_COMPACTA_HPP
+#define ARVORE_AVL_COMPACTA_HPP
+
+#include "MinhaListaEncadeada.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Representa uma árvore AVL com nodos compactos, para guardar muitas chaves pequenas.
+ *
+ * Os nodos ficam em blocos de um pool proprio e se referem aos filhos por indices de 32 bits,
+ * e nao por ponteiros. No lugar da altura, cada nodo guarda o fator de balanceamento em 2 bits,
+ * nos bits mais altos do indice do filho a esquerda, e nao ha ponteiro para o pai nem tamanho
+ * da subarvore. Para chaves int, um nodo ocupa 12 bytes, contra 40 de um nodo de ArvoreAVL.
+ *
+ * Em troca, a arvore nao oferece selecionar, rank nem iteradores: inserir e remover sao
+ * recursivos e corrigem os fatores de balanceamento na volta da recursao. Os nodos removidos
+ * voltam a uma lista de livres do pool e sao reaproveitados pelas proximas insercoes.
+ *
+ * @tparam T O tipo de dado guardado na árvore, que deve ter construtor padrao.
+ * @tparam Comparador A ordem estrita das chaves.
+ */
+template <typename T, typename Comparador = std::less<T>>
+class ArvoreAVLCompacta final
+{
+    using Indice = std::uint32_t;
+
+    /**
+     * @brief o indice 0 nao e usado por nenhum nodo e faz o papel de nullptr
+     */
+    static constexpr Indice nulo = 0;
+
+    static constexpr int bitsDoIndice = 30;
+    static constexpr Indice mascaraDoIndice = (Indice{1} << bitsDoIndice) - 1;
+
+    /**
+     * @brief nodos por bloco do pool; blocos de tamanho fixo evitam copiar os nodos quando o
+     * pool cresce e limitam o espaco reservado e nao usado a um bloco
+     */
+    static constexpr int bitsDoBloco = 12;
+    static constexpr Indice nodosPorBloco = Indice{1} << bitsDoBloco;
+
+    struct NodoCompacto
+    {
+        T chave;
+
+        /**
+         * @brief indice do filho a esquerda nos 30 bits mais baixos e, nos 2 mais altos, o
+         * fator de balanceamento (altura da direita menos altura da esquerda) somado de 1
+         */
+        Indice esquerdaEBalanco{Indice{1} << bitsDoIndice};
+
+        /**
+         * @brief indice do filho a direita; nos nodos livres, o proximo nodo livre
+         */
+        Indice direita{nulo};
+    };
+
+    std::vector<std::unique_ptr<NodoCompacto[]>> blocos;
+
+    /**
+     * @brief quantidade de indices ja entregues pelo pool, contando o indice nulo
+     */
+    Indice usados{1};
+
+    Indice livres{nulo};
+
+    Indice raiz{nulo};
+
+    int n{0};
+
+    Comparador comparador;
+
+public:
+    ArvoreAVLCompacta() = default;
+
+    explicit ArvoreAVLCompacta(Comparador comparador) : comparador{std::move(comparador)} {}
+
+    ArvoreAVLCompacta(ArvoreAVLCompacta const&) = delete;
+    ArvoreAVLCompacta& operator=(ArvoreAVLCompacta const&) = delete;
+
+    /**
+     * @brief Move os nodos de outra arvore para uma nova arvore. A outra arvore fica vazia.
+     */
+    ArvoreAVLCompacta(ArvoreAVLCompacta&& outra) noexcept :
+        blocos{std::move(outra.blocos)}, usados{outra.usados}, livres{outra.livres}, raiz{outra.raiz}, n{outra.n},
+        comparador{std::move(outra.comparador)}
+    {
+        outra.usados = 1;
+        outra.livres = nulo;
+        outra.raiz = nulo;
+        outra.n = 0;
+    }
+
+    /**
+     * @brief Verifica se a arvore esta vazia
+     * @return Verdade se a arvore esta vazia.
+     */
+    bool vazia() const
+    {
+        return raiz == nulo;
+    }
+
+    /**
+     * @brief Retornar quantidade de chaves na arvore
+     * @return Numero natural que representa a quantidade de chaves na arvore
+     */
+    int quantidade() const
+    {
+        return n;
+    }
+
+    /**
+     * @brief Verifica se a arvore contem uma chave
+     * @param chave chave a ser procurada na arvore
+     * @return Verdade se a arvore contem a chave
+     */
+    bool contem(T const& chave) const
+    {
+        Indice indice = raiz;
+
+        while (indice != nulo)
+        {
+            NodoCompacto const& nodo = nodoEm(indice);
+
+            if (comparador(chave, nodo.chave))
+            {
+                indice = nodo.esquerdaEBalanco & mascaraDoIndice;
+            }
+            else if (comparador(nodo.chave, chave))
+            {
+                indice = nodo.direita;
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Retorna a altura da arvore, calculada descendo sempre pelo lado mais alto
+     * @return Altura da arvore, -1 se a arvore esta vazia
+     */
+    int altura() const
+    {
+        int altura = -1;
+
+        for (Indice indice = raiz; indice != nulo; altura++)
+        {
+            indice = (balancoDe(indice) < 0) ? esquerdaDe(indice) : direitaDe(indice);
+        }
+
+        return altura;
+    }
+
+    /**
+     * @brief Insere uma chave na arvore
+     * @param chave chave a ser inserida
+     */
+    void inserir(T const& chave)
+    {
+        insere(chave);
+    }
+
+    /**
+     * @brief Insere uma chave na arvore, movendo-a para dentro do nodo
+     * @param chave chave a ser inserida
+     */
+    void inserir(T&& chave)
+    {
+        insere(std::move(chave));
+    }
+
+    /**
+     * @brief Remove uma chave da arvore
+     * @param chave chave a ser removida
+     * @return Verdade se uma chave foi removida
+     */
+    bool remover(T const& chave)
+    {
+        bool diminuiu = false;
+        bool removido = false;
+
+        raiz = removeRec(raiz, chave, diminuiu, removido);
+
+        if (removido)
+        {
+            n--;
+        }
+
+        return removido;
+    }
+
+    /**
+     * @brief Lista chaves visitando a arvore em ordem
+     * @return Lista encadeada contendo as chaves em ordem.
+     */
+    ListaEncadeadaAbstrata<T> *emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T> *lista = new MinhaListaEncadeada<T>;
+        emOrdemRec(raiz, lista);
+        return lista;
+    }
+
+    /**
+     * @brief Retorna os bytes ocupados pelos blocos do pool, incluindo os nodos livres e os
+     * ainda nao usados do ultimo bloco
+     */
+    std::size_t bytesReservados() const
+    {
+        return blocos.size() * nodosPorBloco * sizeof(NodoCompacto);
+    }
+
+private:
+    NodoCompacto& nodoEm(Indice indice)
+    {
+        return blocos[indice >> bitsDoBloco][indice & (nodosPorBloco - 1)];
+    }
+
+    NodoCompacto const& nodoEm(Indice indice) const
+    {
+        return blocos[indice >> bitsDoBloco][indice & (nodosPorBloco - 1)];
+    }
+
+    Indice esquerdaDe(Indice indice) const
+    {
+        return nodoEm(indice).esquerdaEBalanco & mascaraDoIndice;
+    }
+
+    Indice direitaDe(Indice indice) const
+    {
+        return nodoEm(indice).direita;
+    }
+
+    /**
+     * @brief fator de balanceamento do nodo: -1, 0 ou 1
+     */
+    int balancoDe(Indice indice) const
+    {
+        return static_cast<int>(nodoEm(indice).esquerdaEBalanco >> bitsDoIndice) - 1;
+    }
+
+    void defineEsquerda(Indice indice, Indice esquerda)
+    {
+        Indice& campo = nodoEm(indice).esquerdaEBalanco;
+        campo = (campo & ~mascaraDoIndice) | esquerda;
+    }
+
+    void defineDireita(Indice indice, Indice direita)
+    {
+        nodoEm(indice).direita = direita;
+    }
+
+    void defineBalanco(Indice indice, int balanco)
+    {
+        Indice& campo = nodoEm(indice).esquerdaEBalanco;
+        campo = (campo & mascaraDoIndice) | (static_cast<Indice>(balanco + 1) << bitsDoIndice);
+    }
+
+    /**
+     * @brief entrega um nodo sem filhos e balanceado com a chave dada, reaproveitando um nodo
+     * livre se houver
+     */
+    template <typename Chave>
+    Indice criaNodo(Chave&& chave)
+    {
+        Indice indice = livres;
+
+        if (indice != nulo)
+        {
+            livres = nodoEm(indice).direita;
+        }
+        else
+        {
+            if (usados > mascaraDoIndice)
+            {
+                throw std::length_error("ArvoreAVLCompacta: limite de nodos atingido");
+            }
+
+            if ((usados >> bitsDoBloco) == blocos.size())
+            {
+                blocos.emplace_back(new NodoCompacto[nodosPorBloco]);
+            }
+
+            indice = usados++;
+        }
+
+        NodoCompacto& nodo = nodoEm(indice);
+        nodo.chave = std::forward<Chave>(chave);
+        nodo.esquerdaEBalanco = Indice{1} << bitsDoIndice;
+        nodo.direita = nulo;
+
+        return indice;
+    }
+
+    /**
+     * @brief devolve um nodo a lista de livres; a chave e substituida por uma vazia para
+     * liberar os recursos que ela possa ter
+     */
+    void liberaNodo(Indice indice)
+    {
+        NodoCompacto& nodo = nodoEm(indice);
+
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            nodo.chave = T();
+        }
+
+        nodo.direita = livres;
+        livres = indice;
+    }
+
+    template <typename Chave>
+    void insere(Chave&& chave)
+    {
+        bool cresceu = false;
+        raiz = insereRec(raiz, std::forward<Chave>(chave), cresceu);
+        n++;
+    }
+
+    /**
+     * @brief insere uma chave em uma subarvore; chaves iguais vao para a direita
+     * @param indice raiz da subarvore
+     * @param cresceu recebe verdade se a altura da subarvore aumentou
+     * @return nova raiz da subarvore
+     */
+    template <typename Chave>
+    Indice insereRec(Indice indice, Chave&& chave, bool& cresceu)
+    {
+        if (indice == nulo)
+        {
+            cresceu = true;
+            return criaNodo(std::forward<Chave>(chave));
+        }
+
+        // nenhuma referencia ao nodo e mantida durante a recursao, que pode criar um bloco
+        if (comparador(chave, nodoEm(indice).chave))
+        {
+            defineEsquerda(indice, insereRec(esquerdaDe(indice), std::forward<Chave>(chave), cresceu));
+
+            if (cresceu)
+            {
+                indice = esquerdaCresceu(indice, cresceu);
+            }
+        }
+        else
+        {
+            defineDireita(indice, insereRec(direitaDe(indice), std::forward<Chave>(chave), cresceu));
+
+            if (cresceu)
+            {
+                indice = direitaCresceu(indice, cresceu);
+            }
+        }
+
+        return indice;
+    }
+
+    /**
+     * @brief remove uma chave de uma subarvore
+     * @param indice raiz da subarvore
+     * @param diminuiu recebe verdade se a altura da subarvore diminuiu
+     * @param removido recebe verdade se a chave estava na subarvore
+     * @return nova raiz da subarvore
+     */
+    Indice removeRec(Indice indice, T const& chave, bool& diminuiu, bool& removido)
+    {
+        if (indice == nulo)
+        {
+            diminuiu = false;
+            return nulo;
+        }
+
+        if (comparador(chave, nodoEm(indice).chave))
+        {
+            defineEsquerda(indice, removeRec(esquerdaDe(indice), chave, diminuiu, removido));
+
+            if (diminuiu)
+            {
+                indice = esquerdaDiminuiu(indice, diminuiu);
+            }
+
+            return indice;
+        }
+
+        if (comparador(nodoEm(indice).chave, chave))
+        {
+            defineDireita(indice, removeRec(direitaDe(indice), chave, diminuiu, removido));
+
+            if (diminuiu)
+            {
+                indice = direitaDiminuiu(indice, diminuiu);
+            }
+
+            return indice;
+        }
+
+        removido = true;
+
+        Indice esquerda = esquerdaDe(indice);
+        Indice direita = direitaDe(indice);
+
+        if (esquerda == nulo || direita == nulo)
+        {
+            liberaNodo(indice);
+            diminuiu = true;
+            return (esquerda != nulo) ? esquerda : direita;
+        }
+
+        // o sucessor e desligado da subarvore a direita e ocupa o lugar do nodo removido
+        Indice sucessor = nulo;
+        direita = removeMinimoRec(direita, sucessor, diminuiu);
+
+        defineEsquerda(sucessor, esquerda);
+        defineDireita(sucessor, direita);
+        defineBalanco(sucessor, balancoDe(indice));
+        liberaNodo(indice);
+
+        if (diminuiu)
+        {
+            sucessor = direitaDiminuiu(sucessor, diminuiu);
+        }
+
+        return sucessor;
+    }
+
+    /**
+     * @brief desliga o menor nodo de uma subarvore
+     * @param indice raiz da subarvore
+     * @param minimo recebe o nodo desligado
+     * @param diminuiu recebe verdade se a altura da subarvore diminuiu
+     * @return nova raiz da subarvore
+     */
+    Indice removeMinimoRec(Indice indice, Indice& minimo, bool& diminuiu)
+    {
+        if (esquerdaDe(indice) == nulo)
+        {
+            minimo = indice;
+            diminuiu = true;
+            return direitaDe(indice);
+        }
+
+        defineEsquerda(indice, removeMinimoRec(esquerdaDe(indice), minimo, diminuiu));
+
+        if (diminuiu)
+        {
+            indice = esquerdaDiminuiu(indice, diminuiu);
+        }
+
+        return indice;
+    }
+
+    /**
+     * @brief corrige o balanceamento apos a subarvore a esquerda crescer
+     * @param cresceu continua verdade se a altura da subarvore do nodo tambem aumentou
+     * @return nova raiz da subarvore
+     */
+    Indice esquerdaCresceu(Indice indice, bool& cresceu)
+    {
+        switch (balancoDe(indice))
+        {
+        case 1:
+            defineBalanco(indice, 0);
+            cresceu = false;
+            return indice;
+        case 0:
+            defineBalanco(indice, -1);
+            return indice;
+        default:
+            // a rotacao devolve a subarvore a altura que tinha antes da insercao
+            cresceu = false;
+            return corrigeEsquerdaMaior(indice);
+        }
+    }
+
+    Indice direitaCresceu(Indice indice, bool& cresceu)
+    {
+        switch (balancoDe(indice))
+        {
+        case -1:
+            defineBalanco(indice, 0);
+            cresceu = false;
+            return indice;
+        case 0:
+            defineBalanco(indice, 1);
+            return indice;
+        default:
+            cresceu = false;
+            return corrigeDireitaMaior(indice);
+        }
+    }
+
+    /**
+     * @brief corrige o balanceamento apos a subarvore a esquerda diminuir
+     * @param diminuiu continua verdade se a altura da subarvore do nodo tambem diminuiu
+     * @return nova raiz da subarvore
+     */
+    Indice esquerdaDiminuiu(Indice indice, bool& diminuiu)
+    {
+        switch (balancoDe(indice))
+        {
+        case -1:
+            defineBalanco(indice, 0);
+            return indice;
+        case 0:
+            defineBalanco(indice, 1);
+            diminuiu = false;
+            return indice;
+        default:
+            // se o filho a direita estava balanceado, a rotacao mantem a altura da subarvore
+            diminuiu = balancoDe(direitaDe(indice)) != 0;
+            return corrigeDireitaMaior(indice);
+        }
+    }
+
+    Indice direitaDiminuiu(Indice indice, bool& diminuiu)
+    {
+        switch (balancoDe(indice))
+        {
+        case 1:
+            defineBalanco(indice, 0);
+            return indice;
+        case 0:
+            defineBalanco(indice, -1);
+            diminuiu = false;
+            return indice;
+        default:
+            diminuiu = balancoDe(esquerdaDe(indice)) != 0;
+            return corrigeEsquerdaMaior(indice);
+        }
+    }
+
+    /**
+     * @brief rotaciona um nodo cuja subarvore a direita e duas unidades mais alta que a
+     * esquerda, ajustando os fatores de balanceamento
+     * @return nova raiz da subarvore
+     */
+    Indice corrigeDireitaMaior(Indice indice)
+    {
+        Indice direita = direitaDe(indice);
+        int balanco_direita = balancoDe(direita);
+
+        if (balanco_direita >= 0)
+        {
+            // rotacao simples a esquerda
+            defineDireita(indice, esquerdaDe(direita));
+            defineEsquerda(direita, indice);
+
+            defineBalanco(indice, (balanco_direita == 0) ? 1 : 0);
+            defineBalanco(direita, (balanco_direita == 0) ? -1 : 0);
+            return direita;
+        }
+
+        // rotacao dupla: o neto a esquerda do filho a direita sobe para a raiz
+        Indice neto = esquerdaDe(direita);
+        int balanco_neto = balancoDe(neto);
+
+        defineEsquerda(direita, direitaDe(neto));
+        defineDireita(indice, esquerdaDe(neto));
+        defineEsquerda(neto, indice);
+        defineDireita(neto, direita);
+
+        defineBalanco(indice, (balanco_neto > 0) ? -1 : 0);
+        defineBalanco(direita, (balanco_neto < 0) ? 1 : 0);
+        defineBalanco(neto, 0);
+        return neto;
+    }
+
+    Indice corrigeEsquerdaMaior(Indice indice)
+    {
+        Indice esquerda = esquerdaDe(indice);
+        int balanco_esquerda = balancoDe(esquerda);
+
+        if (balanco_esquerda <= 0)
+        {
+            // rotacao simples a direita
+            defineEsquerda(indice, direitaDe(esquerda));
+            defineDireita(esquerda, indice);
+
+            defineBalanco(indice, (balanco_esquerda == 0) ? -1 : 0);
+            defineBalanco(esquerda, (balanco_esquerda == 0) ? 1 : 0);
+            return esquerda;
+        }
+
+        Indice neto = direitaDe(esquerda);
+        int balanco_neto = balancoDe(neto);
+
+        defineDireita(esquerda, esquerdaDe(neto));
+        defineEsquerda(indice, direitaDe(neto));
+        defineDireita(neto, indice);
+        defineEsquerda(neto, esquerda);
+
+        defineBalanco(indice, (balanco_neto < 0) ? 1 : 0);
+        defineBalanco(esquerda, (balanco_neto > 0) ? -1 : 0);
+        defineBalanco(neto, 0);
+        return neto;
+    }
+
+    void emOrdemRec(Indice indice, ListaEncadeadaAbstrata<T> *lista) const
+    {
+        if (indice != nulo)
+        {
+            emOrdemRec(esquerdaDe(indice), lista);
+            lista->inserirNoFim(nodoEm(indice).chave);
+            emOrdemRec(direitaDe(indice), lista);
+        }
+    }
+};
+
+#endif
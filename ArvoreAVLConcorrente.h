@@ -0,0 +1,667 @@
+#ifndef ARVORE_AVL_CONCORRENTE_HPP
+#define ARVORE_AVL_CONCORRENTE_HPP
+
+#include "ColetorPorEpocas.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Representa uma árvore AVL que pode ser lida por muitas threads enquanto outras a
+ * alteram.
+ *
+ * Leituras (contem, altura e consultas de intervalo) nao usam travas: cada nodo tem um
+ * contador de versao, impar enquanto um escritor o altera. O leitor anota a versao de cada
+ * nodo em que toca e, ao final, confere que nenhuma mudou; se alguma mudou (por exemplo, por
+ * uma rotacao no caminho), a leitura e refeita. Cada passo de um escritor (ligar um nodo, uma
+ * rotacao, trocar um nodo removido pelo sucessor) altera de uma vez o nodo pai e os nodos
+ * envolvidos, de modo que entre dois passos a arvore sempre tem o conjunto de chaves correto.
+ *
+ * Escritores sao serializados entre si por uma trava. Nodos removidos sao liberados por
+ * reclamacao baseada em epocas, depois que nenhum leitor pode mais alcanca-los.
+ *
+ * As chaves sao distintas: inserir uma chave que ja esta na arvore nao tem efeito.
+ *
+ * @tparam T O tipo de dado guardado na árvore.
+ */
+template <typename T>
+class ArvoreAVLConcorrente final
+{
+    /**
+     * @brief nodo com filhos e altura atomicos e um contador de versao; a chave nunca muda
+     */
+    struct NodoVersionado
+    {
+        T const chave;
+        std::atomic<int> altura{0};
+        std::atomic<NodoVersionado *> filhoEsquerda{nullptr};
+        std::atomic<NodoVersionado *> filhoDireita{nullptr};
+        std::atomic<std::uint64_t> versao{0};
+
+        explicit NodoVersionado(T const& chave) : chave{chave} {}
+    };
+
+    /**
+     * @brief um ponteiro para nodo (a raiz ou o filho de um nodo) e a versao de quem o guarda
+     */
+    struct Ligacao
+    {
+        std::atomic<std::uint64_t> *versao;
+        std::atomic<NodoVersionado *> *nodo;
+    };
+
+    /**
+     * @brief versao de um nodo anotada por um leitor
+     */
+    struct Leitura
+    {
+        std::atomic<std::uint64_t> const *versao;
+        std::uint64_t valor;
+    };
+
+    /**
+     * @brief torna impar a versao de um nodo enquanto existir, marcando-o como em alteracao
+     */
+    class Alteracao
+    {
+    public:
+        explicit Alteracao(std::atomic<std::uint64_t>& versao) : versao{versao}, valor{versao.load(std::memory_order_relaxed)}
+        {
+            versao.store(valor + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        Alteracao(Alteracao const&) = delete;
+        Alteracao& operator=(Alteracao const&) = delete;
+
+        ~Alteracao()
+        {
+            versao.store(valor + 2, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<std::uint64_t>& versao;
+        std::uint64_t valor;
+    };
+
+    /**
+     * @brief nenhum caminho de uma AVL passa disto; um leitor que passa esta preso em nodos
+     * que estavam sendo alterados e recomeca
+     */
+    static constexpr int profundidadeMaxima = 128;
+
+    /**
+     * @brief leituras otimistas tentadas antes de o leitor esperar pelos escritores
+     */
+    static constexpr int tentativasOtimistas = 16;
+
+    std::atomic<NodoVersionado *> raiz{nullptr};
+    std::atomic<std::uint64_t> versaoRaiz{0};
+    std::atomic<int> _quantidade{0};
+
+    mutable std::mutex escrita;
+    ColetorPorEpocas<NodoVersionado> coletor;
+
+public:
+    ArvoreAVLConcorrente() = default;
+
+    ArvoreAVLConcorrente(ArvoreAVLConcorrente const&) = delete;
+    ArvoreAVLConcorrente& operator=(ArvoreAVLConcorrente const&) = delete;
+
+    /**
+     * @brief Libera todos os nodos. Nenhuma outra thread pode estar usando a arvore.
+     */
+    ~ArvoreAVLConcorrente()
+    {
+        destrutor(raiz.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Verifica se a arvore esta vazia
+     * @return Verdade se a arvore esta vazia.
+     */
+    bool vazia() const
+    {
+        return quantidade() == 0;
+    }
+
+    /**
+     * @brief Retornar quantidade de chaves na arvore
+     * @return Numero natural que representa a quantidade de chaves na arvore
+     */
+    int quantidade() const
+    {
+        return _quantidade.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Verifica se a arvore contem uma chave, sem travas
+     * @param chave chave a ser procurada na arvore
+     * @return Verdade se a arvore contem a chave
+     */
+    bool contem(T const& chave) const
+    {
+        bool encontrada{false};
+
+        ler([&](bool validar) {
+            return procura(chave, validar, encontrada, nullptr);
+        });
+
+        return encontrada;
+    }
+
+    /**
+     * @brief Retorna a altura da (sub)arvore, sem travas
+     * @param chave chave que é raiz da (sub)arvore cuja altura queremos.
+     * @return Numero inteiro representando a altura da (subarvore). Se chave nao esta na arvore, retorna std::nullopt
+     */
+    std::optional<int> altura(T const& chave) const
+    {
+        bool encontrada{false};
+        int altura_nodo{0};
+
+        ler([&](bool validar) {
+            return procura(chave, validar, encontrada, &altura_nodo);
+        });
+
+        return encontrada ? std::optional<int>{altura_nodo} : std::nullopt;
+    }
+
+    /**
+     * @brief Conta as chaves no intervalo [inicio, fim], sem travas, em O(log n + k)
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @return Numero de chaves da arvore no intervalo
+     */
+    int contarIntervalo(T const& inicio, T const& fim) const
+    {
+        int contagem{0};
+        std::vector<Leitura> lidas;
+
+        ler([&](bool validar) {
+            contagem = 0;
+            lidas.clear();
+            return percorreIntervalo(inicio, fim, lidas, [&](T const&) { contagem++; }) &&
+                   (!validar || valida(lidas));
+        });
+
+        return contagem;
+    }
+
+    /**
+     * @brief Visita em ordem as chaves da arvore no intervalo [inicio, fim]. As chaves sao
+     * lidas sem travas e copiadas; o visitante e chamado depois, com um retrato consistente
+     * do intervalo
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @param visitante funcao chamada com cada chave; se retorna bool, false interrompe a visita
+     */
+    template <typename Visitante>
+    void visitarIntervalo(T const& inicio, T const& fim, Visitante&& visitante) const
+    {
+        std::vector<T> chaves;
+        std::vector<Leitura> lidas;
+
+        ler([&](bool validar) {
+            chaves.clear();
+            lidas.clear();
+            return percorreIntervalo(inicio, fim, lidas, [&](T const& chave) { chaves.push_back(chave); }) &&
+                   (!validar || valida(lidas));
+        });
+
+        for (T const& chave : chaves)
+        {
+            if constexpr (std::is_same<std::invoke_result_t<Visitante&, T const&>, bool>::value)
+            {
+                if (!visitante(chave))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                visitante(chave);
+            }
+        }
+    }
+
+    /**
+     * @brief Insere uma chave na arvore, se ela ainda nao esta
+     * @param chave chave a ser inserida
+     * @return Verdade se a chave foi inserida
+     */
+    bool inserir(T const& chave)
+    {
+        std::lock_guard<std::mutex> trava{escrita};
+
+        Ligacao caminho[profundidadeMaxima];
+        int profundidade{0};
+        Ligacao ligacao{&versaoRaiz, &raiz};
+
+        for (NodoVersionado *nodo = ligacao.nodo->load(std::memory_order_relaxed); nodo != nullptr; nodo = ligacao.nodo->load(std::memory_order_relaxed))
+        {
+            if (!(chave < nodo->chave) && !(nodo->chave < chave))
+            {
+                return false;
+            }
+
+            caminho[profundidade++] = ligacao;
+            ligacao = filho(nodo, chave < nodo->chave);
+        }
+
+        NodoVersionado *novo = new NodoVersionado{chave};
+
+        {
+            Alteracao alteracao{*ligacao.versao};
+            ligacao.nodo->store(novo, std::memory_order_release);
+        }
+
+        _quantidade.fetch_add(1, std::memory_order_relaxed);
+
+        // como no retracing da MinhaArvoreAVL, para quando a altura de uma subarvore nao muda
+        while (profundidade > 0 && rebalanceia(caminho[--profundidade]))
+        {
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Remove uma chave da arvore
+     * @param chave chave a removida
+     * @return Verdade se a chave estava na arvore
+     */
+    bool remover(T const& chave)
+    {
+        std::lock_guard<std::mutex> trava{escrita};
+
+        Ligacao caminho[profundidadeMaxima];
+        int profundidade{0};
+        Ligacao ligacao{&versaoRaiz, &raiz};
+        NodoVersionado *nodo = ligacao.nodo->load(std::memory_order_relaxed);
+
+        while (nodo != nullptr && (chave < nodo->chave || nodo->chave < chave))
+        {
+            caminho[profundidade++] = ligacao;
+            ligacao = filho(nodo, chave < nodo->chave);
+            nodo = ligacao.nodo->load(std::memory_order_relaxed);
+        }
+
+        if (nodo == nullptr)
+        {
+            return false;
+        }
+
+        NodoVersionado *esquerda = nodo->filhoEsquerda.load(std::memory_order_relaxed);
+        NodoVersionado *direita = nodo->filhoDireita.load(std::memory_order_relaxed);
+
+        if (esquerda == nullptr || direita == nullptr)
+        {
+            Alteracao alteracao{*ligacao.versao};
+            ligacao.nodo->store((esquerda != nullptr) ? esquerda : direita, std::memory_order_release);
+        }
+        else
+        {
+            profundidade = substituiPeloSucessor(ligacao, nodo, caminho, profundidade);
+        }
+
+        _quantidade.fetch_sub(1, std::memory_order_relaxed);
+
+        // na remocao, segue enquanto a altura das subarvores diminui
+        while (profundidade > 0 && rebalanceia(caminho[--profundidade]))
+        {
+        }
+
+        coletor.aposentar(nodo);
+        coletor.tentarAvancar();
+
+        return true;
+    }
+
+private:
+    /**
+     * @brief executa uma leitura otimista, sob a protecao do coletor, ate que ela seja
+     * validada; apos muitas falhas, le com a trava dos escritores, o que sempre e valido
+     * @param leitura funcao que recebe se deve validar e retorna se a leitura foi valida
+     */
+    template <typename Funcao>
+    void ler(Funcao&& leitura) const
+    {
+        for (int tentativa = 0; tentativa < tentativasOtimistas; tentativa++)
+        {
+            typename ColetorPorEpocas<NodoVersionado>::Guarda guarda{coletor};
+
+            if (leitura(true))
+            {
+                return;
+            }
+        }
+
+        std::lock_guard<std::mutex> trava{escrita};
+        leitura(false);
+    }
+
+    /**
+     * @brief anota a versao de um nodo ou da raiz
+     * @return falso se um escritor esta alterando o nodo
+     */
+    static bool anota(std::atomic<std::uint64_t> const& versao, Leitura *lidas, int& quantidade_lidas)
+    {
+        std::uint64_t const valor{versao.load(std::memory_order_acquire)};
+
+        if (valor % 2 != 0)
+        {
+            return false;
+        }
+
+        lidas[quantidade_lidas++] = {&versao, valor};
+        return true;
+    }
+
+    /**
+     * @brief confere que nenhuma das versoes anotadas mudou desde que foi lida
+     */
+    static bool valida(Leitura const *lidas, int quantidade_lidas)
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        for (int i = 0; i < quantidade_lidas; i++)
+        {
+            if (lidas[i].versao->load(std::memory_order_relaxed) != lidas[i].valor)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool valida(std::vector<Leitura> const& lidas)
+    {
+        return valida(lidas.data(), static_cast<int>(lidas.size()));
+    }
+
+    /**
+     * @brief procura uma chave anotando as versoes do caminho
+     * @param validar se deve conferir as versoes ao final
+     * @param encontrada recebe se a chave esta na arvore
+     * @param altura_nodo se nao e nullptr, recebe a altura do nodo encontrado
+     * @return verdade se a leitura foi valida
+     */
+    bool procura(T const& chave, bool validar, bool& encontrada, int *altura_nodo) const
+    {
+        Leitura lidas[profundidadeMaxima + 1];
+        int quantidade_lidas{0};
+
+        encontrada = false;
+
+        if (!anota(versaoRaiz, lidas, quantidade_lidas))
+        {
+            return false;
+        }
+
+        NodoVersionado *nodo = raiz.load(std::memory_order_acquire);
+
+        while (nodo != nullptr)
+        {
+            if (quantidade_lidas > profundidadeMaxima || !anota(nodo->versao, lidas, quantidade_lidas))
+            {
+                return false;
+            }
+
+            if (chave < nodo->chave)
+            {
+                nodo = nodo->filhoEsquerda.load(std::memory_order_acquire);
+            }
+            else if (nodo->chave < chave)
+            {
+                nodo = nodo->filhoDireita.load(std::memory_order_acquire);
+            }
+            else
+            {
+                encontrada = true;
+
+                if (altura_nodo != nullptr)
+                {
+                    *altura_nodo = nodo->altura.load(std::memory_order_relaxed);
+                }
+
+                break;
+            }
+        }
+
+        return !validar || valida(lidas, quantidade_lidas);
+    }
+
+    /**
+     * @brief percorre em ordem as chaves no intervalo [inicio, fim], anotando as versoes da
+     * raiz e dos nodos visitados
+     * @param coleta funcao chamada com cada chave do intervalo
+     * @return falso se encontrou um nodo em alteracao ou um caminho longo demais
+     */
+    template <typename Coleta>
+    bool percorreIntervalo(T const& inicio, T const& fim, std::vector<Leitura>& lidas, Coleta&& coleta) const
+    {
+        std::uint64_t const valor{versaoRaiz.load(std::memory_order_acquire)};
+
+        if (valor % 2 != 0)
+        {
+            return false;
+        }
+
+        lidas.push_back({&versaoRaiz, valor});
+        return percorreSubarvore(raiz.load(std::memory_order_acquire), inicio, fim, lidas, 0, coleta);
+    }
+
+    template <typename Coleta>
+    static bool percorreSubarvore(NodoVersionado *nodo, T const& inicio, T const& fim, std::vector<Leitura>& lidas, int profundidade, Coleta& coleta)
+    {
+        if (nodo == nullptr)
+        {
+            return true;
+        }
+
+        std::uint64_t const valor{nodo->versao.load(std::memory_order_acquire)};
+
+        if (profundidade > profundidadeMaxima || valor % 2 != 0)
+        {
+            return false;
+        }
+
+        lidas.push_back({&nodo->versao, valor});
+
+        if (inicio < nodo->chave && !percorreSubarvore(nodo->filhoEsquerda.load(std::memory_order_acquire), inicio, fim, lidas, profundidade + 1, coleta))
+        {
+            return false;
+        }
+
+        if (!(nodo->chave < inicio) && !(fim < nodo->chave))
+        {
+            coleta(nodo->chave);
+        }
+
+        return !(nodo->chave < fim) || percorreSubarvore(nodo->filhoDireita.load(std::memory_order_acquire), inicio, fim, lidas, profundidade + 1, coleta);
+    }
+
+    /**
+     * @brief a ligacao para o filho a esquerda ou a direita de um nodo
+     */
+    static Ligacao filho(NodoVersionado *nodo, bool esquerda)
+    {
+        return {&nodo->versao, esquerda ? &nodo->filhoEsquerda : &nodo->filhoDireita};
+    }
+
+    static int alturaDe(NodoVersionado *nodo)
+    {
+        return (nodo == nullptr) ? -1 : nodo->altura.load(std::memory_order_relaxed);
+    }
+
+    static int alturaPelosFilhos(NodoVersionado *nodo)
+    {
+        return 1 + std::max(alturaDe(nodo->filhoEsquerda.load(std::memory_order_relaxed)), alturaDe(nodo->filhoDireita.load(std::memory_order_relaxed)));
+    }
+
+    static int fatorDeBalanceamento(NodoVersionado *nodo)
+    {
+        return alturaDe(nodo->filhoEsquerda.load(std::memory_order_relaxed)) - alturaDe(nodo->filhoDireita.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief troca um nodo com dois filhos pelo seu sucessor, alterando de uma vez o pai do
+     * nodo, o sucessor e o pai do sucessor
+     * @param ligacao ligacao para o nodo removido
+     * @param nodo nodo removido
+     * @param caminho ligacoes ate o nodo removido, completadas ate o pai do sucessor
+     * @param profundidade quantidade de ligacoes no caminho
+     * @return a nova quantidade de ligacoes no caminho
+     */
+    int substituiPeloSucessor(Ligacao ligacao, NodoVersionado *nodo, Ligacao *caminho, int profundidade)
+    {
+        NodoVersionado *pai_sucessor = nullptr;
+        NodoVersionado *sucessor = nodo->filhoDireita.load(std::memory_order_relaxed);
+
+        caminho[profundidade++] = ligacao;
+
+        // ligacao, apos a troca, para o filho a direita do nodo removido
+        int const posicao_direita{profundidade};
+
+        for (NodoVersionado *esquerda = sucessor->filhoEsquerda.load(std::memory_order_relaxed); esquerda != nullptr;
+             esquerda = sucessor->filhoEsquerda.load(std::memory_order_relaxed))
+        {
+            // a ligacao para o filho a direita so e conhecida quando o sucessor for encontrado
+            caminho[profundidade++] = (pai_sucessor == nullptr) ? Ligacao{} : filho(pai_sucessor, true);
+            pai_sucessor = sucessor;
+            sucessor = esquerda;
+        }
+
+        if (pai_sucessor != nullptr)
+        {
+            caminho[posicao_direita] = filho(sucessor, false);
+
+            Alteracao alteracao_ligacao{*ligacao.versao};
+            Alteracao alteracao_pai{pai_sucessor->versao};
+            Alteracao alteracao_sucessor{sucessor->versao};
+
+            pai_sucessor->filhoEsquerda.store(sucessor->filhoDireita.load(std::memory_order_relaxed), std::memory_order_release);
+            sucessor->filhoDireita.store(nodo->filhoDireita.load(std::memory_order_relaxed), std::memory_order_release);
+            sucessor->filhoEsquerda.store(nodo->filhoEsquerda.load(std::memory_order_relaxed), std::memory_order_release);
+            sucessor->altura.store(nodo->altura.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            ligacao.nodo->store(sucessor, std::memory_order_release);
+
+            return profundidade;
+        }
+
+        Alteracao alteracao_ligacao{*ligacao.versao};
+        Alteracao alteracao_sucessor{sucessor->versao};
+
+        sucessor->filhoEsquerda.store(nodo->filhoEsquerda.load(std::memory_order_relaxed), std::memory_order_release);
+        sucessor->altura.store(nodo->altura.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        ligacao.nodo->store(sucessor, std::memory_order_release);
+
+        return profundidade;
+    }
+
+    /**
+     * @brief ajusta a altura do nodo apontado pela ligacao, rotacionando se ele esta
+     * desbalanceado
+     * @param ligacao ligacao para a raiz da subarvore
+     * @return verdade se a altura da subarvore mudou
+     */
+    bool rebalanceia(Ligacao ligacao)
+    {
+        NodoVersionado *nodo = ligacao.nodo->load(std::memory_order_relaxed);
+        int const altura_antiga{nodo->altura.load(std::memory_order_relaxed)};
+        int const fator{fatorDeBalanceamento(nodo)};
+
+        if (fator > 1)
+        {
+            if (fatorDeBalanceamento(nodo->filhoEsquerda.load(std::memory_order_relaxed)) < 0)
+            {
+                rotacaoSimplesEsquerda(filho(nodo, true));
+            }
+
+            rotacaoSimplesDireita(ligacao);
+        }
+        else if (fator < -1)
+        {
+            if (fatorDeBalanceamento(nodo->filhoDireita.load(std::memory_order_relaxed)) > 0)
+            {
+                rotacaoSimplesDireita(filho(nodo, false));
+            }
+
+            rotacaoSimplesEsquerda(ligacao);
+        }
+        else
+        {
+            int const altura_nova{alturaPelosFilhos(nodo)};
+
+            if (altura_nova != altura_antiga)
+            {
+                Alteracao alteracao{nodo->versao};
+                nodo->altura.store(altura_nova, std::memory_order_relaxed);
+            }
+        }
+
+        return alturaDe(ligacao.nodo->load(std::memory_order_relaxed)) != altura_antiga;
+    }
+
+    /**
+     * @brief rotaciona para a direita a subarvore apontada pela ligacao, alterando de uma vez
+     * o pai, a antiga raiz e a nova raiz
+     */
+    void rotacaoSimplesDireita(Ligacao ligacao)
+    {
+        NodoVersionado *nodo = ligacao.nodo->load(std::memory_order_relaxed);
+        NodoVersionado *nova_raiz = nodo->filhoEsquerda.load(std::memory_order_relaxed);
+
+        Alteracao alteracao_ligacao{*ligacao.versao};
+        Alteracao alteracao_nodo{nodo->versao};
+        Alteracao alteracao_nova_raiz{nova_raiz->versao};
+
+        nodo->filhoEsquerda.store(nova_raiz->filhoDireita.load(std::memory_order_relaxed), std::memory_order_release);
+        nova_raiz->filhoDireita.store(nodo, std::memory_order_release);
+        nodo->altura.store(alturaPelosFilhos(nodo), std::memory_order_relaxed);
+        nova_raiz->altura.store(alturaPelosFilhos(nova_raiz), std::memory_order_relaxed);
+        ligacao.nodo->store(nova_raiz, std::memory_order_release);
+    }
+
+    /**
+     * @brief rotaciona para a esquerda a subarvore apontada pela ligacao, alterando de uma
+     * vez o pai, a antiga raiz e a nova raiz
+     */
+    void rotacaoSimplesEsquerda(Ligacao ligacao)
+    {
+        NodoVersionado *nodo = ligacao.nodo->load(std::memory_order_relaxed);
+        NodoVersionado *nova_raiz = nodo->filhoDireita.load(std::memory_order_relaxed);
+
+        Alteracao alteracao_ligacao{*ligacao.versao};
+        Alteracao alteracao_nodo{nodo->versao};
+        Alteracao alteracao_nova_raiz{nova_raiz->versao};
+
+        nodo->filhoDireita.store(nova_raiz->filhoEsquerda.load(std::memory_order_relaxed), std::memory_order_release);
+        nova_raiz->filhoEsquerda.store(nodo, std::memory_order_release);
+        nodo->altura.store(alturaPelosFilhos(nodo), std::memory_order_relaxed);
+        nova_raiz->altura.store(alturaPelosFilhos(nova_raiz), std::memory_order_relaxed);
+        ligacao.nodo->store(nova_raiz, std::memory_order_release);
+    }
+
+    /**
+     * @brief libera todos os nodos de uma subarvore
+     */
+    void destrutor(NodoVersionado *nodo)
+    {
+        if (nodo != nullptr)
+        {
+            destrutor(nodo->filhoEsquerda.load(std::memory_order_relaxed));
+            destrutor(nodo->filhoDireita.load(std::memory_order_relaxed));
+            delete nodo;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,402 @@
+#ifndef ARVORE_AVL_PERSISTENTE_HPP
+#define ARVORE_AVL_PERSISTENTE_HPP
+
+#include "MinhaListaEncadeada.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief Representa uma árvore AVL persistente: inserir e remover copiam apenas os O(log n)
+ * nodos do caminho alterado e compartilham o restante com as versoes anteriores.
+ *
+ * Copiar a arvore (ou chamar retrato) e O(1) e produz uma versao independente: alteracoes em
+ * uma nao aparecem na outra. Os nodos sao imutaveis e contam referencias; um nodo e liberado
+ * quando nenhuma versao o usa mais. As contagens sao atomicas, entao versoes diferentes podem
+ * ser lidas e alteradas por threads diferentes ao mesmo tempo.
+ *
+ * @tparam T O tipo de dado guardado na árvore.
+ */
+template <typename T>
+class ArvoreAVLPersistente final
+{
+    /**
+     * @brief nodo imutavel, compartilhado entre as versoes que o alcancam
+     */
+    struct NodoPersistente
+    {
+        T const chave;
+        int const altura;
+        int const tamanho;
+        NodoPersistente const *const filhoEsquerda;
+        NodoPersistente const *const filhoDireita;
+        mutable std::atomic<int> referencias{1};
+    };
+
+    NodoPersistente const *raiz{nullptr};
+
+public:
+    ArvoreAVLPersistente() = default;
+
+    /**
+     * @brief Constroi uma arvore perfeitamente balanceada a partir de chaves ordenadas, em O(n)
+     * @param primeiro inicio da sequencia de chaves, em ordem nao decrescente
+     * @param ultimo fim da sequencia de chaves
+     */
+    template <typename Iterador>
+    ArvoreAVLPersistente(Iterador primeiro, Iterador ultimo)
+    {
+        raiz = construirRec(primeiro, static_cast<int>(std::distance(primeiro, ultimo)));
+    }
+
+    /**
+     * @brief Cria, em O(1), uma versao independente com as mesmas chaves
+     */
+    ArvoreAVLPersistente(ArvoreAVLPersistente const& outra) : raiz{retem(outra.raiz)} {}
+
+    ArvoreAVLPersistente(ArvoreAVLPersistente&& outra) noexcept : raiz{outra.raiz}
+    {
+        outra.raiz = nullptr;
+    }
+
+    ArvoreAVLPersistente& operator=(ArvoreAVLPersistente outra) noexcept
+    {
+        std::swap(raiz, outra.raiz);
+        return *this;
+    }
+
+    ~ArvoreAVLPersistente()
+    {
+        libera(raiz);
+    }
+
+    /**
+     * @brief Retorna, em O(1), um retrato da arvore que continua legivel e inalterado
+     * enquanto esta arvore e alterada
+     * @return Versao independente com as chaves atuais
+     */
+    ArvoreAVLPersistente retrato() const
+    {
+        return *this;
+    }
+
+    /**
+     * @brief Verifica se a arvore esta vazia
+     * @return Verdade se a arvore esta vazia.
+     */
+    bool vazia() const
+    {
+        return raiz == nullptr;
+    }
+
+    /**
+     * @brief Retornar quantidade de chaves na arvore
+     * @return Numero natural que representa a quantidade de chaves na arvore
+     */
+    int quantidade() const
+    {
+        return tamanhoDe(raiz);
+    }
+
+    /**
+     * @brief Verifica se a arvore contem uma chave
+     * @param chave chave a ser procurada na arvore
+     * @return Verdade se a arvore contem a chave
+     */
+    bool contem(T const& chave) const
+    {
+        return procuraChave(chave) != nullptr;
+    }
+
+    /**
+     * @brief Retorna a altura da (sub)arvore
+     * @param chave chave que é raiz da (sub)arvore cuja altura queremos.
+     * @return Numero inteiro representando a altura da (subarvore). Se chave nao esta na arvore, retorna std::nullopt
+     */
+    std::optional<int> altura(T const& chave) const
+    {
+        NodoPersistente const *nodo = procuraChave(chave);
+
+        if (nodo == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return nodo->altura;
+    }
+
+    /**
+     * @brief Insere uma chave na arvore, copiando apenas o caminho ate ela
+     * @param chave chave a ser inserida
+     */
+    void inserir(T const& chave)
+    {
+        NodoPersistente const *nova_raiz = insereRec(raiz, chave);
+        libera(raiz);
+        raiz = nova_raiz;
+    }
+
+    /**
+     * @brief Remove uma chave da arvore, copiando apenas o caminho ate ela
+     * @param chave chave a removida
+     */
+    void remover(T const& chave)
+    {
+        bool removeu{false};
+        NodoPersistente const *nova_raiz = removeRec(raiz, chave, removeu);
+        libera(raiz);
+        raiz = nova_raiz;
+    }
+
+    /**
+     * @brief Obtém uma lista com as chaves da árvore percorridas em ordem
+     * @return Lista encadeada com as chaves em ordem
+     */
+    ListaEncadeadaAbstrata<T> *emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T> *lista = new MinhaListaEncadeada<T>();
+        emOrdemRec(raiz, lista);
+        return lista;
+    }
+
+private:
+    static int alturaDe(NodoPersistente const *nodo)
+    {
+        return (nodo == nullptr) ? -1 : nodo->altura;
+    }
+
+    static int tamanhoDe(NodoPersistente const *nodo)
+    {
+        return (nodo == nullptr) ? 0 : nodo->tamanho;
+    }
+
+    /**
+     * @brief acrescenta uma referencia a um nodo
+     * @return o proprio nodo
+     */
+    static NodoPersistente const *retem(NodoPersistente const *nodo)
+    {
+        if (nodo != nullptr)
+        {
+            nodo->referencias.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return nodo;
+    }
+
+    /**
+     * @brief retira uma referencia de um nodo, liberando-o (e, em seguida, seus filhos) se
+     * era a ultima
+     */
+    static void libera(NodoPersistente const *nodo)
+    {
+        while (nodo != nullptr && nodo->referencias.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            libera(nodo->filhoEsquerda);
+
+            NodoPersistente const *direita = nodo->filhoDireita;
+            delete nodo;
+            nodo = direita;
+        }
+    }
+
+    /**
+     * @brief cria um nodo que passa a ser dono das referencias para os filhos dados
+     */
+    static NodoPersistente const *criaNodo(T const& chave, NodoPersistente const *esquerda, NodoPersistente const *direita)
+    {
+        return new NodoPersistente{chave, 1 + std::max(alturaDe(esquerda), alturaDe(direita)),
+                                   1 + tamanhoDe(esquerda) + tamanhoDe(direita), esquerda, direita};
+    }
+
+    /**
+     * @brief cria um nodo com a chave e os filhos dados, rotacionando se as alturas dos filhos
+     * diferem em 2. Como os nodos sao imutaveis, cada rotacao cria novos nodos em vez de
+     * religar os existentes
+     * @param chave chave do nodo
+     * @param esquerda subarvore a esquerda, cuja referencia passa a ser do resultado
+     * @param direita subarvore a direita, cuja referencia passa a ser do resultado
+     * @return raiz balanceada da subarvore
+     */
+    static NodoPersistente const *balanceia(T const& chave, NodoPersistente const *esquerda, NodoPersistente const *direita)
+    {
+        int const fator{alturaDe(esquerda) - alturaDe(direita)};
+
+        if (fator > 1)
+        {
+            NodoPersistente const *resultado;
+
+            if (alturaDe(esquerda->filhoEsquerda) >= alturaDe(esquerda->filhoDireita))
+            {
+                // rotacao simples a direita
+                resultado = criaNodo(esquerda->chave, retem(esquerda->filhoEsquerda),
+                                     criaNodo(chave, retem(esquerda->filhoDireita), direita));
+            }
+            else
+            {
+                // rotacao esquerda-direita
+                NodoPersistente const *meio = esquerda->filhoDireita;
+                resultado = criaNodo(meio->chave, criaNodo(esquerda->chave, retem(esquerda->filhoEsquerda), retem(meio->filhoEsquerda)),
+                                     criaNodo(chave, retem(meio->filhoDireita), direita));
+            }
+
+            libera(esquerda);
+            return resultado;
+        }
+
+        if (fator < -1)
+        {
+            NodoPersistente const *resultado;
+
+            if (alturaDe(direita->filhoDireita) >= alturaDe(direita->filhoEsquerda))
+            {
+                // rotacao simples a esquerda
+                resultado = criaNodo(direita->chave, criaNodo(chave, esquerda, retem(direita->filhoEsquerda)),
+                                     retem(direita->filhoDireita));
+            }
+            else
+            {
+                // rotacao direita-esquerda
+                NodoPersistente const *meio = direita->filhoEsquerda;
+                resultado = criaNodo(meio->chave, criaNodo(chave, esquerda, retem(meio->filhoEsquerda)),
+                                     criaNodo(direita->chave, retem(meio->filhoDireita), retem(direita->filhoDireita)));
+            }
+
+            libera(direita);
+            return resultado;
+        }
+
+        return criaNodo(chave, esquerda, direita);
+    }
+
+    /**
+     * @brief insere a chave em uma copia do caminho; chaves iguais vao para a direita
+     * @return nova raiz da subarvore, com uma referencia do chamador
+     */
+    static NodoPersistente const *insereRec(NodoPersistente const *nodo, T const& chave)
+    {
+        if (nodo == nullptr)
+        {
+            return criaNodo(chave, nullptr, nullptr);
+        }
+
+        if (chave < nodo->chave)
+        {
+            return balanceia(nodo->chave, insereRec(nodo->filhoEsquerda, chave), retem(nodo->filhoDireita));
+        }
+
+        return balanceia(nodo->chave, retem(nodo->filhoEsquerda), insereRec(nodo->filhoDireita, chave));
+    }
+
+    /**
+     * @brief remove a chave de uma copia do caminho; se a chave nao esta na subarvore, ela e
+     * compartilhada sem copias
+     * @param removeu recebe se a chave foi encontrada
+     * @return nova raiz da subarvore, com uma referencia do chamador
+     */
+    static NodoPersistente const *removeRec(NodoPersistente const *nodo, T const& chave, bool& removeu)
+    {
+        if (nodo == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (chave < nodo->chave || nodo->chave < chave)
+        {
+            bool const pela_esquerda{chave < nodo->chave};
+            NodoPersistente const *novo_filho = removeRec(pela_esquerda ? nodo->filhoEsquerda : nodo->filhoDireita, chave, removeu);
+
+            if (!removeu)
+            {
+                libera(novo_filho);
+                return retem(nodo);
+            }
+
+            return pela_esquerda ? balanceia(nodo->chave, novo_filho, retem(nodo->filhoDireita))
+                                 : balanceia(nodo->chave, retem(nodo->filhoEsquerda), novo_filho);
+        }
+
+        removeu = true;
+
+        if (nodo->filhoEsquerda == nullptr)
+        {
+            return retem(nodo->filhoDireita);
+        }
+
+        if (nodo->filhoDireita == nullptr)
+        {
+            return retem(nodo->filhoEsquerda);
+        }
+
+        // o sucessor ocupa o lugar do nodo removido
+        NodoPersistente const *sucessor = nodo->filhoDireita;
+
+        while (sucessor->filhoEsquerda != nullptr)
+        {
+            sucessor = sucessor->filhoEsquerda;
+        }
+
+        return balanceia(sucessor->chave, retem(nodo->filhoEsquerda), removeMinimoRec(nodo->filhoDireita));
+    }
+
+    /**
+     * @brief remove o menor nodo de uma copia do caminho ate ele
+     * @return nova raiz da subarvore, com uma referencia do chamador
+     */
+    static NodoPersistente const *removeMinimoRec(NodoPersistente const *nodo)
+    {
+        if (nodo->filhoEsquerda == nullptr)
+        {
+            return retem(nodo->filhoDireita);
+        }
+
+        return balanceia(nodo->chave, removeMinimoRec(nodo->filhoEsquerda), retem(nodo->filhoDireita));
+    }
+
+    NodoPersistente const *procuraChave(T const& chave) const
+    {
+        NodoPersistente const *nodo = raiz;
+
+        while (nodo != nullptr && (chave < nodo->chave || nodo->chave < chave))
+        {
+            nodo = (chave < nodo->chave) ? nodo->filhoEsquerda : nodo->filhoDireita;
+        }
+
+        return nodo;
+    }
+
+    /**
+     * @brief constroi recursivamente a subarvore com as proximas quantidade chaves
+     */
+    template <typename Iterador>
+    static NodoPersistente const *construirRec(Iterador& atual, int quantidade)
+    {
+        if (quantidade == 0)
+        {
+            return nullptr;
+        }
+
+        int const quantidade_esquerda{quantidade / 2};
+        NodoPersistente const *esquerda = construirRec(atual, quantidade_esquerda);
+        T const chave{*atual};
+        ++atual;
+
+        return criaNodo(chave, esquerda, construirRec(atual, quantidade - quantidade_esquerda - 1));
+    }
+
+    static void emOrdemRec(NodoPersistente const *nodo, ListaEncadeadaAbstrata<T> *lista)
+    {
+        if (nodo != nullptr)
+        {
+            emOrdemRec(nodo->filhoEsquerda, lista);
+            lista->inserirNoFim(nodo->chave);
+            emOrdemRec(nodo->filhoDireita, lista);
+        }
+    }
+};
+
+#endif
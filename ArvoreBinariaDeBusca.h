@@ -4,23 +4,16 @@
 #include "MinhaListaEncadeada.h"
 #include <optional>
 
-template<typename T>
-struct Nodo
-{
-    T chave;
-    int altura{0};
-    Nodo* filhoEsquerda{nullptr};
-    Nodo* filhoDireita{nullptr}; 
-};
-
+/**
+ * @brief Interface de uma arvore binaria de busca, para codigo que precisa escolher a
+ * implementacao em tempo de execucao. As implementacoes guardam seus proprios nodos.
+ *
+ * @tparam T O tipo de dado guardado na árvore.
+ */
 template<typename T>
 class ArvoreBinariaDeBusca
 {
-protected:
-    Nodo<T>* raiz;
-
 public:
-    ArvoreBinariaDeBusca();
     virtual ~ArvoreBinariaDeBusca();
 
     /**
@@ -40,18 +33,41 @@ public:
      * @param chave chave a ser procurada na arvore
      * @return Verdade se a arvore contem a chave
      */
-    virtual bool contem(T chave) const = 0;
+    virtual bool contem(T const& chave) const = 0;
     
     /**
      * @brief Retorna a altura da (sub)arvore
      * @param chave chave que é raiz da (sub)arvore cuja altura queremos. 
      * @return Numero inteiro representando a altura da (subarvore). Se chave nao esta na arvore, retorna std::nullopt
      */
-    virtual std::optional<int> altura(T chave) const = 0;
+    virtual std::optional<int> altura(T const& chave) const = 0;
+
+    /**
+     * @brief Busca a k-esima menor chave da arvore
+     * @param k posicao da chave na arvore em ordem, na faixa [0, quantidade)
+     * @return A k-esima menor chave. Se k esta fora da faixa, retorna std::nullopt
+     */
+    virtual std::optional<T> selecionar(int k) const = 0;
+
+    /**
+     * @brief Conta as chaves da arvore estritamente menores que uma chave
+     * @param chave chave de referencia, nao precisa estar na arvore
+     * @return Numero natural que representa a posicao em que a chave estaria na arvore em ordem
+     */
+    virtual int rank(T const& chave) const = 0;
+
+    /**
+     * @brief Conta as chaves da arvore no intervalo [inicio, fim]
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @return Numero natural que representa a quantidade de chaves no intervalo
+     */
+    virtual int contarIntervalo(T const& inicio, T const& fim) const = 0;
 
     /**
      * @brief Insere uma chave na arvore
-     * @param chave chave a ser inserida
+     * @param chave chave a ser inserida; recebida por valor para que a implementacao possa
+     * move-la para dentro do nodo
      */        
     virtual void inserir(T chave) = 0;
 
@@ -59,21 +75,21 @@ public:
      * @brief Remove uma chave da arvore
      * @param chave chave a removida
      */        
-    virtual void remover(T chave) = 0;
+    virtual void remover(T const& chave) = 0;
 
     /**
      * @brief Busca a chave do filho a esquerda de uma (sub)arvore
      * @param chave chave da arvore que eh pai do filho a esquerda
      * @return Chave do filho a esquerda. Se chave nao esta na arvore, retorna std::nullopt
      */
-    virtual std::optional<T> filhoEsquerdaDe(T chave) const = 0;
+    virtual std::optional<T> filhoEsquerdaDe(T const& chave) const = 0;
 
     /**
      * @brief Busca a chave do filho a direita de uma (sub)arvore
      * @param chave chave da arvore que eh pai do filho a direita
      * @return Chave do filho a direita. Se chave nao esta na arvore, retorna nullptr
      */        
-    virtual std::optional<T> filhoDireitaDe(T chave) const = 0;
+    virtual std::optional<T> filhoDireitaDe(T const& chave) const = 0;
 
     /**
      * @brief Lista chaves visitando a arvore em ordem
@@ -94,11 +110,6 @@ public:
     virtual ListaEncadeadaAbstrata<T>* posOrdem() const = 0;
 };
 
-template<typename T>
-ArvoreBinariaDeBusca<T>::ArvoreBinariaDeBusca():
-    raiz{} // instancia _raiz com nullptr. Equivalente a _raiz{nullptr}
-{}
-
 template<typename T>
 ArvoreBinariaDeBusca<T>::~ArvoreBinariaDeBusca() = default; //atribui destrutor padrao do C++.
 
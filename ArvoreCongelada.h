@@ -0,0 +1,317 @@
+#ifndef ARVORE_CONGELADA_HPP
+#define ARVORE_CONGELADA_HPP
+
+#include "MinhaListaEncadeada.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Representa um indice imutavel, para consultas, com as chaves de uma arvore de busca
+ * guardadas em um vetor na ordem de Eytzinger (a ordem de uma busca em largura: os filhos da
+ * posicao k ficam nas posicoes 2k e 2k + 1).
+ *
+ * Os primeiros niveis ficam juntos no inicio do vetor e sao reaproveitados por todas as
+ * buscas. Para chaves aritmeticas, cada busca desce sem desvios condicionais e busca
+ * antecipadamente a linha de cache com os descendentes quatro niveis abaixo, de modo que os
+ * acessos a memoria de niveis diferentes se sobrepoem em vez de esperar um pelo outro. Para
+ * as demais chaves, a descida usa um desvio, que o processador preve e executa adiante.
+ *
+ * @tparam T O tipo de dado guardado, que deve ter construtor padrao.
+ * @tparam Comparador A ordem estrita das chaves, a mesma da arvore de origem.
+ */
+template <typename T, typename Comparador = std::less<T>>
+class ArvoreCongelada final
+{
+    /**
+     * @brief alocador que alinha o vetor ao inicio de uma linha de cache, para que os
+     * descendentes de uma posicao, buscados antecipadamente, ocupem uma unica linha
+     */
+    template <typename U>
+    struct AlocadorAlinhado
+    {
+        using value_type = U;
+
+        AlocadorAlinhado() = default;
+
+        template <typename V>
+        AlocadorAlinhado(AlocadorAlinhado<V> const&) {}
+
+        U *allocate(std::size_t quantidade)
+        {
+            return static_cast<U *>(::operator new(quantidade * sizeof(U), std::align_val_t{linhaDeCache}));
+        }
+
+        void deallocate(U *ponteiro, std::size_t)
+        {
+            ::operator delete(ponteiro, std::align_val_t{linhaDeCache});
+        }
+
+        template <typename V>
+        bool operator==(AlocadorAlinhado<V> const&) const { return true; }
+
+        template <typename V>
+        bool operator!=(AlocadorAlinhado<V> const&) const { return false; }
+    };
+
+    static constexpr std::size_t linhaDeCache = 64;
+
+    /**
+     * @brief quantas chaves cabem em uma linha de cache; os descendentes da posicao k a
+     * log2(porLinha) niveis abaixo comecam na posicao k * porLinha
+     */
+    static constexpr std::size_t porLinha = (sizeof(T) < linhaDeCache) ? linhaDeCache / sizeof(T) : 1;
+
+    /**
+     * @brief chaves na ordem de Eytzinger, a partir da posicao 1; a posicao 0 nao e usada
+     */
+    std::vector<T, AlocadorAlinhado<T>> chaves;
+
+    /**
+     * @brief posicao, na ordem crescente, da chave em cada posicao do vetor
+     */
+    std::vector<std::uint32_t> ordem;
+
+    std::size_t n{0};
+
+    Comparador comparador;
+
+public:
+    ArvoreCongelada() : chaves(1), ordem(1) {}
+
+    /**
+     * @brief Constroi o indice a partir de chaves ordenadas, em O(n)
+     * @param primeiro inicio da sequencia de chaves, em ordem nao decrescente
+     * @param ultimo fim da sequencia de chaves
+     * @param comparador a ordem das chaves
+     */
+    template <typename Iterador>
+    ArvoreCongelada(Iterador primeiro, Iterador ultimo, Comparador comparador = Comparador()) :
+        n{static_cast<std::size_t>(std::distance(primeiro, ultimo))}, comparador{std::move(comparador)}
+    {
+        chaves.resize(n + 1);
+        ordem.resize(n + 1);
+
+        std::uint32_t posicao{0};
+        preenche(primeiro, 1, posicao);
+    }
+
+    /**
+     * @brief Verifica se o indice esta vazio
+     * @return Verdade se o indice esta vazio.
+     */
+    bool vazia() const
+    {
+        return n == 0;
+    }
+
+    /**
+     * @brief Retornar quantidade de chaves no indice
+     * @return Numero natural que representa a quantidade de chaves no indice
+     */
+    int quantidade() const
+    {
+        return static_cast<int>(n);
+    }
+
+    /**
+     * @brief Verifica se o indice contem uma chave
+     * @param chave chave a ser procurada
+     * @return Verdade se o indice contem a chave
+     */
+    bool contem(T const& chave) const
+    {
+        std::size_t const k{limiteInferior(chave)};
+        return k != 0 && !comparador(chave, chaves[k]);
+    }
+
+    /**
+     * @brief Conta as chaves no intervalo [inicio, fim], em O(log n)
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @return Numero de chaves no intervalo
+     */
+    int contarIntervalo(T const& inicio, T const& fim) const
+    {
+        if (comparador(fim, inicio))
+        {
+            return 0;
+        }
+
+        return static_cast<int>(posicaoDe(limiteSuperior(fim)) - posicaoDe(limiteInferior(inicio)));
+    }
+
+    /**
+     * @brief Visita em ordem as chaves no intervalo [inicio, fim]
+     * @param inicio menor chave do intervalo
+     * @param fim maior chave do intervalo
+     * @param visitante funcao chamada com cada chave; se retorna bool, false interrompe a visita
+     */
+    template <typename Visitante>
+    void visitarIntervalo(T const& inicio, T const& fim, Visitante&& visitante) const
+    {
+        for (std::size_t k = limiteInferior(inicio); k != 0 && !comparador(fim, chaves[k]); k = sucessor(k))
+        {
+            if constexpr (std::is_same<std::invoke_result_t<Visitante&, T const&>, bool>::value)
+            {
+                if (!visitante(chaves[k]))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                visitante(chaves[k]);
+            }
+        }
+    }
+
+    /**
+     * @brief Obtém uma lista com as chaves percorridas em ordem
+     * @return Lista encadeada com as chaves em ordem
+     */
+    ListaEncadeadaAbstrata<T> *emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T> *lista = new MinhaListaEncadeada<T>();
+
+        for (std::size_t k = (n == 0) ? 0 : maisEsquerda(1); k != 0; k = sucessor(k))
+        {
+            lista->inserirNoFim(chaves[k]);
+        }
+
+        return lista;
+    }
+
+private:
+    /**
+     * @brief coloca as chaves ordenadas na subarvore implicita da posicao k, em ordem
+     */
+    template <typename Iterador>
+    void preenche(Iterador& atual, std::size_t k, std::uint32_t& posicao)
+    {
+        if (k <= n)
+        {
+            preenche(atual, 2 * k, posicao);
+            chaves[k] = *atual;
+            ordem[k] = posicao++;
+            ++atual;
+            preenche(atual, 2 * k + 1, posicao);
+        }
+    }
+
+    /**
+     * @brief desce ate uma folha, indo para a direita enquanto a chave da posicao
+     * nao satisfaz o criterio; a ultima posicao em que desceu para a esquerda e a resposta
+     * @param vaiParaDireita criterio de comparacao com a chave procurada
+     * @return posicao da resposta, ou 0 se nao ha nenhuma
+     */
+    template <typename Criterio>
+    std::size_t desce(Criterio vaiParaDireita) const
+    {
+        T const *dados = chaves.data();
+        std::size_t k{1};
+
+        if constexpr (std::is_arithmetic<T>::value)
+        {
+            while (k <= n)
+            {
+#if defined(__GNUC__)
+                __builtin_prefetch(dados + k * porLinha);
+#endif
+                k = 2 * k + static_cast<std::size_t>(vaiParaDireita(dados[k]));
+            }
+        }
+        else
+        {
+            /**
+             * chaves como std::string guardam os dados fora do vetor, onde a busca antecipada
+             * nao alcanca; com um desvio, o processador preve a direcao e ja comeca a carregar
+             * o proximo nivel, em vez de esperar cada comparacao terminar
+             */
+            while (k <= n)
+            {
+                if (vaiParaDireita(dados[k]))
+                {
+                    k = 2 * k + 1;
+                }
+                else
+                {
+                    k = 2 * k;
+                }
+            }
+        }
+
+        // desfaz as descidas para a direita apos a ultima descida para a esquerda
+#if defined(__GNUC__)
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+#else
+        while (k & 1)
+        {
+            k >>= 1;
+        }
+
+        return k >> 1;
+#endif
+    }
+
+    /**
+     * @brief posicao da menor chave maior ou igual a chave dada, ou 0 se nao ha nenhuma
+     */
+    std::size_t limiteInferior(T const& chave) const
+    {
+        return desce([this, &chave](T const& atual) { return comparador(atual, chave); });
+    }
+
+    /**
+     * @brief posicao da menor chave maior que a chave dada, ou 0 se nao ha nenhuma
+     */
+    std::size_t limiteSuperior(T const& chave) const
+    {
+        return desce([this, &chave](T const& atual) { return !comparador(chave, atual); });
+    }
+
+    /**
+     * @brief posicao na ordem crescente da chave na posicao k; n para a posicao 0 (o fim)
+     */
+    std::size_t posicaoDe(std::size_t k) const
+    {
+        return (k == 0) ? n : ordem[k];
+    }
+
+    std::size_t maisEsquerda(std::size_t k) const
+    {
+        while (2 * k <= n)
+        {
+            k = 2 * k;
+        }
+
+        return k;
+    }
+
+    /**
+     * @brief posicao da proxima chave em ordem, ou 0 se k e a ultima
+     */
+    std::size_t sucessor(std::size_t k) const
+    {
+        if (2 * k + 1 <= n)
+        {
+            return maisEsquerda(2 * k + 1);
+        }
+
+        // sobe enquanto k e filho a direita
+        while (k & 1)
+        {
+            k >>= 1;
+        }
+
+        return k >> 1;
+    }
+};
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef DEC0006_COLETOR_POR_EPOCAS_H
+#define DEC0006_COLETOR_POR_EPOCAS_H
+
+#include <atomic>
+// std::atomic
+#include <cstddef>
+// std::size_t
+#include <cstdint>
+// std::uint64_t
+#include <functional>
+// std::hash
+#include <thread>
+// std::this_thread
+#include <vector>
+// std::vector
+
+/**
+ * @brief Libera nodos removidos de uma estrutura somente quando nenhum
+ * leitor pode mais estar usando-os (reclamacao baseada em epocas).
+ *
+ * Cada leitor anuncia, enquanto le, a epoca global em que comecou. Um nodo
+ * aposentado na epoca e so e liberado quando a epoca global chega a e + 2, o
+ * que exige que todos os leitores que podiam ve-lo tenham terminado.
+ *
+ * Os leitores podem ser muitas threads ao mesmo tempo; aposentar e
+ * tentarAvancar devem ser chamados por um escritor por vez.
+ *
+ * @tparam N O tipo de nodo, liberado com delete.
+ */
+template<typename N>
+class ColetorPorEpocas
+{
+public:
+    /**
+     * @brief Mantem a thread atual registrada como leitora enquanto existir.
+     *
+     */
+    class Guarda
+    {
+    public:
+        explicit Guarda(ColetorPorEpocas const& coletor):
+            _coletor{coletor},
+            _vaga{coletor.entrar()}
+        {}
+
+        Guarda(Guarda const&) = delete;
+        Guarda& operator=(Guarda const&) = delete;
+
+        ~Guarda()
+        {
+            _coletor.sair(_vaga);
+        }
+
+    private:
+        ColetorPorEpocas const& _coletor;
+        std::size_t _vaga;
+    };
+
+    ColetorPorEpocas() = default;
+
+    ColetorPorEpocas(ColetorPorEpocas const&) = delete;
+    ColetorPorEpocas& operator=(ColetorPorEpocas const&) = delete;
+
+    /**
+     * @brief Libera todos os nodos aposentados. Nenhum leitor pode estar
+     * ativo.
+     *
+     */
+    ~ColetorPorEpocas()
+    {
+        for (std::vector<N*>& aposentados : _aposentados)
+        {
+            libera(aposentados);
+        }
+    }
+
+    /**
+     * @brief Agenda a liberacao de um nodo que ja nao e alcancavel pela
+     * estrutura.
+     *
+     * @param nodo O nodo removido.
+     */
+    void aposentar(N* nodo)
+    {
+        _aposentados[_epoca.load(std::memory_order_relaxed) % 3].push_back(nodo);
+    }
+
+    /**
+     * @brief Avanca a epoca global se todos os leitores ativos ja a
+     * observaram, liberando os nodos aposentados duas epocas antes.
+     *
+     */
+    void tentarAvancar()
+    {
+        std::uint64_t const epoca{_epoca.load(std::memory_order_relaxed)};
+
+        // os nodos aposentados precisam estar desligados antes de olhar as vagas
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        for (Vaga const& vaga : _vagas)
+        {
+            std::uint64_t const anunciada{vaga.epoca.load(std::memory_order_seq_cst)};
+
+            if (anunciada != livre && anunciada != epoca + 1)
+            {
+                return;
+            }
+        }
+
+        _epoca.store(epoca + 1, std::memory_order_seq_cst);
+        libera(_aposentados[(epoca + 2) % 3]);
+    }
+
+private:
+    /**
+     * @brief Vaga de um leitor. Guarda a epoca anunciada mais um, ou livre.
+     * Cada vaga ocupa sua propria linha de cache.
+     *
+     */
+    struct alignas(64) Vaga
+    {
+        std::atomic<std::uint64_t> epoca{livre};
+    };
+
+    static constexpr std::uint64_t livre = 0;
+    static constexpr std::size_t quantidadeDeVagas = 64;
+
+    /**
+     * @brief Ocupa uma vaga, comecando pela sugerida pelo id da thread, e
+     * anuncia nela a epoca atual.
+     *
+     * @return O indice da vaga ocupada.
+     */
+    std::size_t entrar() const
+    {
+        std::size_t vaga{std::hash<std::thread::id>{}(std::this_thread::get_id()) % quantidadeDeVagas};
+
+        for (std::size_t tentativas = 1;; tentativas++)
+        {
+            std::uint64_t esperado{livre};
+
+            if (_vagas[vaga].epoca.compare_exchange_strong(esperado, _epoca.load(std::memory_order_seq_cst) + 1, std::memory_order_seq_cst))
+            {
+                // o anuncio precisa ser visivel antes da leitura de qualquer nodo
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return vaga;
+            }
+
+            vaga = (vaga + 1) % quantidadeDeVagas;
+
+            if (tentativas % quantidadeDeVagas == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void sair(std::size_t const vaga) const
+    {
+        _vagas[vaga].epoca.store(livre, std::memory_order_release);
+    }
+
+    static void libera(std::vector<N*>& aposentados)
+    {
+        for (N* nodo : aposentados)
+        {
+            delete nodo;
+        }
+
+        aposentados.clear();
+    }
+
+    mutable Vaga _vagas[quantidadeDeVagas];
+    std::atomic<std::uint64_t> _epoca{0};
+    std::vector<N*> _aposentados[3];
+};
+
+#endif
@@ -19,19 +19,25 @@ struct Elemento
      * 
      */
     Elemento* proximo;
+    /**
+     * @brief O ponteiro para o elemento anterior na lista. Pode ser nulo.
+     * 
+     */
+    Elemento* anterior;
 
     /**
      * @brief Constrói um novo elemento.
      * 
      * @param dado O dado que será armazenado no elemento.
      * @param proximo O ponteiro para o próximo elemento. Por padrão, é nulo.
+     * @param anterior O ponteiro para o elemento anterior. Por padrão, é nulo.
      */
-    explicit Elemento(T dado, Elemento* proximo = nullptr);
+    explicit Elemento(T dado, Elemento* proximo = nullptr, Elemento* anterior = nullptr);
 };
 
 template<typename T>
-Elemento<T>::Elemento(T const dado, Elemento* const proximo):
-    dado{dado}, proximo{proximo}
+Elemento<T>::Elemento(T const dado, Elemento* const proximo, Elemento* const anterior):
+    dado{dado}, proximo{proximo}, anterior{anterior}
 {}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#ifndef ESTATISTICAS_AVL_HPP
+#define ESTATISTICAS_AVL_HPP
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Contadores das operacoes de uma ArvoreAVL que coleta estatisticas, lidos por
+ * ArvoreAVL::estatisticas(). Cada contador soma os eventos desde a criacao da arvore ou desde
+ * a ultima chamada a zerarEstatisticas().
+ */
+struct EstatisticasAVL
+{
+    /**
+     * @brief chamadas ao comparador, inclusive as de ordenacao de lotes
+     */
+    long long comparacoes{0};
+
+    /**
+     * @brief descidas a partir da raiz: buscas, insercoes, remocoes, rank e selecao
+     */
+    long long buscas{0};
+
+    /**
+     * @brief nodos visitados pelas descidas
+     */
+    long long nodosVisitados{0};
+
+    long long rotacoesSimplesDireita{0};
+    long long rotacoesSimplesEsquerda{0};
+    long long rotacoesDireitaEsquerda{0};
+    long long rotacoesEsquerdaDireita{0};
+
+    /**
+     * @brief passos de um nodo para o seu pai ao subir corrigindo alturas e tamanhos apos
+     * insercoes e remocoes
+     */
+    long long subidasAoPai{0};
+
+    long long alocacoes{0};
+    long long liberacoes{0};
+
+    /**
+     * @brief Quantidade media de nodos visitados por descida
+     */
+    double comprimentoMedioDeBusca() const
+    {
+        return (buscas > 0) ? static_cast<double>(nodosVisitados) / static_cast<double>(buscas) : 0.0;
+    }
+
+    /**
+     * @brief Soma das rotacoes dos quatro tipos
+     */
+    long long rotacoes() const
+    {
+        return rotacoesSimplesDireita + rotacoesSimplesEsquerda + rotacoesDireitaEsquerda + rotacoesEsquerdaDireita;
+    }
+};
+
+/**
+ * @brief contador que pode ser incrementado por varias threads, como nas operacoes de
+ * conjunto em paralelo, e copiado junto com a estrutura que o contem
+ */
+class ContadorDeEventos
+{
+    std::atomic<long long> valor{0};
+
+public:
+    ContadorDeEventos() = default;
+
+    ContadorDeEventos(ContadorDeEventos const& outro):
+        valor{outro.lido()}
+    {}
+
+    ContadorDeEventos& operator=(ContadorDeEventos const& outro)
+    {
+        valor.store(outro.lido(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    void operator+=(long long eventos)
+    {
+        valor.fetch_add(eventos, std::memory_order_relaxed);
+    }
+
+    long long lido() const
+    {
+        return valor.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief contadores de uma arvore; sem estatisticas, a classe e vazia e cada registro e uma
+ * funcao vazia, que o compilador elimina
+ */
+template <bool ColetaEstatisticas>
+struct ContadoresDaArvore
+{
+    void registraBusca() const {}
+    void registraVisita() const {}
+    void registraRotacaoSimplesDireita() const {}
+    void registraRotacaoSimplesEsquerda() const {}
+    void registraRotacaoDireitaEsquerda() const {}
+    void registraRotacaoEsquerdaDireita() const {}
+    void registraSubida() const {}
+    void registraAlocacao() const {}
+    void registraLiberacoes(long long) const {}
+};
+
+template <>
+struct ContadoresDaArvore<true>
+{
+    // as consultas sao const, mas tambem contam
+    mutable ContadorDeEventos buscas;
+    mutable ContadorDeEventos nodosVisitados;
+    mutable ContadorDeEventos rotacoesSimplesDireita;
+    mutable ContadorDeEventos rotacoesSimplesEsquerda;
+    mutable ContadorDeEventos rotacoesDireitaEsquerda;
+    mutable ContadorDeEventos rotacoesEsquerdaDireita;
+    mutable ContadorDeEventos subidasAoPai;
+    mutable ContadorDeEventos alocacoes;
+    mutable ContadorDeEventos liberacoes;
+
+    void registraBusca() const { buscas += 1; }
+    void registraVisita() const { nodosVisitados += 1; }
+    void registraRotacaoSimplesDireita() const { rotacoesSimplesDireita += 1; }
+    void registraRotacaoSimplesEsquerda() const { rotacoesSimplesEsquerda += 1; }
+    void registraRotacaoDireitaEsquerda() const { rotacoesDireitaEsquerda += 1; }
+    void registraRotacaoEsquerdaDireita() const { rotacoesEsquerdaDireita += 1; }
+    void registraSubida() const { subidasAoPai += 1; }
+    void registraAlocacao() const { alocacoes += 1; }
+    void registraLiberacoes(long long quantidade) const { liberacoes += quantidade; }
+
+    /**
+     * @brief copia os contadores, exceto o de comparacoes, que fica no comparador
+     */
+    EstatisticasAVL lidos() const
+    {
+        EstatisticasAVL estatisticas;
+        estatisticas.buscas = buscas.lido();
+        estatisticas.nodosVisitados = nodosVisitados.lido();
+        estatisticas.rotacoesSimplesDireita = rotacoesSimplesDireita.lido();
+        estatisticas.rotacoesSimplesEsquerda = rotacoesSimplesEsquerda.lido();
+        estatisticas.rotacoesDireitaEsquerda = rotacoesDireitaEsquerda.lido();
+        estatisticas.rotacoesEsquerdaDireita = rotacoesEsquerdaDireita.lido();
+        estatisticas.subidasAoPai = subidasAoPai.lido();
+        estatisticas.alocacoes = alocacoes.lido();
+        estatisticas.liberacoes = liberacoes.lido();
+        return estatisticas;
+    }
+};
+
+/**
+ * @brief comparador que conta suas chamadas; converte-se no comparador original, para que
+ * possa ser passado a quem espera o tipo da arvore, como ArvoreCongelada
+ */
+template <typename Comparador>
+struct ComparadorContado
+{
+    Comparador comparador;
+    mutable ContadorDeEventos comparacoes;
+
+    ComparadorContado(Comparador comparador = Comparador()):
+        comparador{std::move(comparador)}
+    {}
+
+    template <typename A, typename B>
+    bool operator()(A const& a, B const& b) const
+    {
+        comparacoes += 1;
+        return comparador(a, b);
+    }
+
+    operator Comparador const&() const
+    {
+        return comparador;
+    }
+};
+
+/**
+ * @brief o comparador guardado pela arvore: o proprio Comparador, ou, com estatisticas, ele
+ * envolvido em um ComparadorContado
+ */
+template <typename Comparador, bool ColetaEstatisticas>
+using ComparadorDaArvore = std::conditional_t<ColetaEstatisticas, ComparadorContado<Comparador>, Comparador>;
+
+#endif
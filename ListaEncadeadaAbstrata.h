@@ -112,8 +112,17 @@ public:
      */
     virtual void remover(T dado) = 0;
 
+    /**
+     * @brief Move todos os itens de outra lista para o fim desta lista. Ao
+     * final, a outra lista fica vazia.
+     * 
+     * @param outra A lista cujos itens serão anexados ao fim desta.
+     */
+    virtual void concatenar(ListaEncadeadaAbstrata<T>& outra) = 0;
+
 protected:
     Elemento<T>* _primeiro{nullptr};
+    Elemento<T>* _ultimo{nullptr};
     std::size_t _tamanho{0};
 };
 
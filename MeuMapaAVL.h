@@ -0,0 +1,366 @@
+#ifndef MEU_MAPA_AVL_HPP
+#define MEU_MAPA_AVL_HPP
+
+#include "ArvoreAVL.h"
+
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+/**
+ * @brief Representa um mapa ordenado de chaves para valores, guardado em uma ArvoreAVL cujos
+ * nodos contem o par (chave, valor). O valor e construido dentro do nodo, sem alocacoes
+ * alem da do proprio nodo, e uma unica busca leva tanto a chave quanto ao valor.
+ *
+ * @tparam K O tipo das chaves.
+ * @tparam V O tipo dos valores.
+ * @tparam Alocador A politica de alocacao dos nodos (AlocadorSlab ou AlocadorNovo).
+ * @tparam Comparador A ordem estrita das chaves.
+ */
+template <typename K, typename V, template <typename> class Alocador = AlocadorSlab, typename Comparador = std::less<K>>
+class MeuMapaAVL
+{
+public:
+    using Entrada = std::pair<K const, V>;
+
+private:
+    /**
+     * @brief ordena as entradas pelas chaves; e transparente para que a arvore possa ser
+     * consultada diretamente por uma chave, sem montar uma entrada
+     */
+    struct ComparaEntradas
+    {
+        using is_transparent = void;
+
+        Comparador comparador;
+
+        bool operator()(Entrada const& a, Entrada const& b) const
+        {
+            return comparador(a.first, b.first);
+        }
+
+        template <typename Chave>
+        bool operator()(Entrada const& a, Chave const& b) const
+        {
+            return comparador(a.first, b);
+        }
+
+        template <typename Chave>
+        bool operator()(Chave const& a, Entrada const& b) const
+        {
+            return comparador(a, b.first);
+        }
+    };
+
+    using Arvore = ArvoreAVL<Entrada, Alocador, ComparaEntradas>;
+
+    Arvore arvore;
+
+public:
+    using const_iterator = typename Arvore::Iterador;
+
+    /**
+     * @brief Iterador bidirecional que percorre as entradas em ordem de chave e permite
+     * alterar os valores
+     */
+    class Iterador
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Entrada;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Entrada*;
+        using reference = Entrada&;
+
+        Iterador() = default;
+
+        reference operator*() const
+        {
+            // os nodos nunca sao constantes; a arvore apenas nao expoe as chaves para escrita
+            return const_cast<Entrada&>(*atual);
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        Iterador& operator++()
+        {
+            ++atual;
+            return *this;
+        }
+
+        Iterador operator++(int)
+        {
+            Iterador anterior = *this;
+            ++*this;
+            return anterior;
+        }
+
+        Iterador& operator--()
+        {
+            --atual;
+            return *this;
+        }
+
+        Iterador operator--(int)
+        {
+            Iterador anterior = *this;
+            --*this;
+            return anterior;
+        }
+
+        bool operator==(Iterador const& outro) const
+        {
+            return atual == outro.atual;
+        }
+
+        bool operator!=(Iterador const& outro) const
+        {
+            return atual != outro.atual;
+        }
+
+        operator const_iterator() const
+        {
+            return atual;
+        }
+
+    private:
+        friend class MeuMapaAVL;
+
+        explicit Iterador(const_iterator atual):
+            atual{atual}
+        {}
+
+        const_iterator atual;
+    };
+
+    using iterator = Iterador;
+
+    MeuMapaAVL() = default;
+
+    /**
+     * @brief Cria um mapa vazio que ordena as chaves com o comparador dado
+     */
+    explicit MeuMapaAVL(Comparador comparador):
+        arvore{ComparaEntradas{std::move(comparador)}}
+    {}
+
+    /**
+     * @brief Verifica se o mapa esta vazio
+     * @return Verdade se o mapa esta vazio.
+     */
+    bool vazia() const
+    {
+        return arvore.vazia();
+    }
+
+    /**
+     * @brief Retornar quantidade de entradas no mapa
+     * @return Numero natural que representa a quantidade de entradas no mapa
+     */
+    int quantidade() const
+    {
+        return arvore.quantidade();
+    }
+
+    /**
+     * @brief Verifica se o mapa contem uma chave
+     * @param chave chave a ser procurada
+     * @return Verdade se o mapa contem a chave
+     */
+    bool contem(K const& chave) const
+    {
+        return arvore.contem(chave);
+    }
+
+    /**
+     * @brief Procura a entrada de uma chave
+     * @param chave chave a ser procurada
+     * @return Iterador para a entrada, cujo valor pode ser alterado, ou end() se o mapa nao
+     * contem a chave
+     */
+    Iterador find(K const& chave)
+    {
+        return Iterador{arvore.procurar(chave)};
+    }
+
+    /**
+     * @brief Procura a entrada de uma chave
+     * @param chave chave a ser procurada
+     * @return Iterador para a entrada, ou end() se o mapa nao contem a chave
+     */
+    const_iterator find(K const& chave) const
+    {
+        return arvore.procurar(chave);
+    }
+
+    /**
+     * @brief Procura a primeira entrada cuja chave nao e menor que uma chave, em O(log n)
+     * @param chave chave de referencia, nao precisa estar no mapa
+     * @return Iterador para a entrada, ou end() se todas as chaves sao menores
+     */
+    Iterador lower_bound(K const& chave)
+    {
+        return Iterador{arvore.lower_bound(chave)};
+    }
+
+    const_iterator lower_bound(K const& chave) const
+    {
+        return arvore.lower_bound(chave);
+    }
+
+    /**
+     * @brief Procura a primeira entrada cuja chave e maior que uma chave, em O(log n)
+     * @param chave chave de referencia, nao precisa estar no mapa
+     * @return Iterador para a entrada, ou end() se nenhuma chave e maior
+     */
+    Iterador upper_bound(K const& chave)
+    {
+        return Iterador{arvore.upper_bound(chave)};
+    }
+
+    const_iterator upper_bound(K const& chave) const
+    {
+        return arvore.upper_bound(chave);
+    }
+
+    /**
+     * @brief Insere uma entrada com o valor construido no nodo a partir dos argumentos, se o
+     * mapa ainda nao contem a chave. Se contem, nada e construido e os argumentos nao sao
+     * consumidos.
+     * @param chave chave da entrada
+     * @param argumentos argumentos do construtor do valor
+     * @return par com o iterador para a entrada da chave e verdade se ela foi inserida
+     */
+    template <typename... Argumentos>
+    std::pair<Iterador, bool> try_emplace(K const& chave, Argumentos&&... argumentos)
+    {
+        return emplaceSeAusente(chave, chave, std::forward<Argumentos>(argumentos)...);
+    }
+
+    /**
+     * @brief Como try_emplace(K const&, ...), mas move a chave para o nodo se a entrada
+     * e inserida
+     */
+    template <typename... Argumentos>
+    std::pair<Iterador, bool> try_emplace(K&& chave, Argumentos&&... argumentos)
+    {
+        return emplaceSeAusente(chave, std::move(chave), std::forward<Argumentos>(argumentos)...);
+    }
+
+    /**
+     * @brief Insere uma entrada ou, se o mapa ja contem a chave, atribui o novo valor a ela
+     * @param chave chave da entrada
+     * @param valor valor da entrada
+     * @return par com o iterador para a entrada da chave e verdade se ela foi inserida
+     */
+    template <typename M>
+    std::pair<Iterador, bool> insert_or_assign(K const& chave, M&& valor)
+    {
+        std::pair<Iterador, bool> resultado = try_emplace(chave, std::forward<M>(valor));
+
+        if (!resultado.second)
+        {
+            resultado.first->second = std::forward<M>(valor);
+        }
+
+        return resultado;
+    }
+
+    /**
+     * @brief Como insert_or_assign(K const&, M&&), mas move a chave para o nodo se a entrada
+     * e inserida
+     */
+    template <typename M>
+    std::pair<Iterador, bool> insert_or_assign(K&& chave, M&& valor)
+    {
+        std::pair<Iterador, bool> resultado = try_emplace(std::move(chave), std::forward<M>(valor));
+
+        if (!resultado.second)
+        {
+            resultado.first->second = std::forward<M>(valor);
+        }
+
+        return resultado;
+    }
+
+    /**
+     * @brief Acessa o valor de uma chave, inserindo uma entrada com o valor padrao se o mapa
+     * nao contem a chave
+     * @param chave chave da entrada
+     * @return Referencia para o valor da chave
+     */
+    V& operator[](K const& chave)
+    {
+        return try_emplace(chave).first->second;
+    }
+
+    /**
+     * @brief Como operator[](K const&), mas move a chave para o nodo se a entrada e inserida
+     */
+    V& operator[](K&& chave)
+    {
+        return try_emplace(std::move(chave)).first->second;
+    }
+
+    /**
+     * @brief Remove a entrada de uma chave
+     * @param chave chave da entrada a ser removida
+     * @return Verdade se uma entrada foi removida
+     */
+    bool remover(K const& chave)
+    {
+        return arvore.remover(chave);
+    }
+
+    /**
+     * @brief Iterador para a entrada de menor chave
+     */
+    Iterador begin()
+    {
+        return Iterador{arvore.begin()};
+    }
+
+    /**
+     * @brief Iterador para a posicao apos a entrada de maior chave
+     */
+    Iterador end()
+    {
+        return Iterador{arvore.end()};
+    }
+
+    const_iterator begin() const
+    {
+        return arvore.begin();
+    }
+
+    const_iterator end() const
+    {
+        return arvore.end();
+    }
+
+private:
+    /**
+     * @brief procura a chave e, se ela nao esta no mapa, constroi a entrada no nodo sem
+     * copiar nem mover o valor
+     * @param chave chave procurada
+     * @param chave_da_entrada argumento do construtor da chave da entrada
+     * @param argumentos argumentos do construtor do valor
+     */
+    template <typename Chave, typename... Argumentos>
+    std::pair<Iterador, bool> emplaceSeAusente(K const& chave, Chave&& chave_da_entrada, Argumentos&&... argumentos)
+    {
+        std::pair<const_iterator, bool> resultado = arvore.inserirSeAusente(
+            chave,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<Chave>(chave_da_entrada)),
+            std::forward_as_tuple(std::forward<Argumentos>(argumentos)...));
+
+        return {Iterador{resultado.first}, resultado.second};
+    }
+};
+
+#endif
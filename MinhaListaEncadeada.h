@@ -120,6 +120,7 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
              * novo elemento é o novo primeiro elemento
              */
             novo_elemento->proximo = this->_primeiro;
+            this->_primeiro->anterior = novo_elemento;
             this->_primeiro = novo_elemento;
         }
         else // lista esta vazia
@@ -129,6 +130,7 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
              * (novo elemento ja foi inicializado apontando para 'nullptr').
              */
             this->_primeiro = novo_elemento;
+            this->_ultimo = novo_elemento;
         }
 
         this->_tamanho++;
@@ -171,6 +173,8 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
             Elemento<T> *temp = procura_posicao->proximo;
 
             procura_posicao->proximo = procura_posicao->proximo->proximo;
+            procura_posicao->anterior = temp;
+            procura_posicao->proximo->anterior = procura_posicao;
             temp->proximo = procura_posicao;
             this->_tamanho++;
         }
@@ -194,27 +198,16 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
      */
     virtual void inserirNoFim(T dado)
     {
-        // ponteiro iterador | novo elemento
-        Elemento<T> *novo_elemento = new Elemento(dado);
+        // novo elemento, ja apontando para o atual ultimo elemento
+        Elemento<T> *novo_elemento = new Elemento<T>(dado, nullptr, this->_ultimo);
 
         if (!vazia())
         {
-
             /**
-             * iterador procura ultimo elemento da lista a partir do
-             * endereco apontado pelo segundo elemento seguinte a ele
-             * (que sera 'nullptr' quando alcançar o último elemento)
+             * o ultimo elemento e conhecido, logo basta encadear o novo
+             * elemento apos ele, sem percorrer a lista
              */
-
-            novo_elemento->proximo = this->_primeiro;
-
-            for (size_t i = 0; i < tamanho() - 1; i++)
-            {
-                novo_elemento->proximo = novo_elemento->proximo->proximo;
-            }
-
-            novo_elemento->proximo->proximo = novo_elemento;
-            novo_elemento->proximo = nullptr;
+            this->_ultimo->proximo = novo_elemento;
         }
         else // lista vazia
         {
@@ -222,6 +215,7 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
             this->_primeiro = novo_elemento;
         }
 
+        this->_ultimo = novo_elemento;
         this->_tamanho++;
     };
 
@@ -244,6 +238,16 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
             T dado = this->_primeiro->dado;
 
             this->_primeiro = this->_primeiro->proximo;
+
+            if (this->_primeiro != nullptr)
+            {
+                this->_primeiro->anterior = nullptr;
+            }
+            else // lista ficou vazia
+            {
+                this->_ultimo = nullptr;
+            }
+
             delete temp;
             this->_tamanho--;
 
@@ -284,6 +288,7 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
 
             delete procura_posicao->proximo;
             procura_posicao->proximo = temp;
+            temp->anterior = procura_posicao;
             this->_tamanho--;
             return dado;
         }
@@ -311,23 +316,16 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
 
         if (!vazia() && tamanho() != 1)
         {
-            //ponteiro iterador
-            Elemento<T> *procura_final = this->_primeiro;
-
             /**
-             * ponteiro iterador procura final da lista e remove ultimo elemento
-             * (ponteiro para apontando para o ultimo elemento)
-            */
-
-            while (procura_final->proximo->proximo != nullptr)
-            {
-                procura_final = procura_final->proximo;
-            }
-
-            T dado = procura_final->proximo->dado;
+             * o penultimo elemento e alcancado pelo ponteiro 'anterior'
+             * do ultimo, sem percorrer a lista
+             */
+            Elemento<T> *temp = this->_ultimo;
+            T dado = temp->dado;
 
-            delete procura_final->proximo;
-            procura_final->proximo = nullptr; //penúltimo elemento é o novo ultimo elemento
+            this->_ultimo = temp->anterior;
+            this->_ultimo->proximo = nullptr; //penúltimo elemento é o novo ultimo elemento
+            delete temp;
             this->_tamanho--;
             return dado;
         }
@@ -363,6 +361,53 @@ class MinhaListaEncadeada :  public ListaEncadeadaAbstrata<T>
             throw ExcecaoDadoInexistente();
         }
     };
+
+    /**
+     * @brief Move todos os itens de outra lista para o fim desta lista. Ao
+     * final, a outra lista fica vazia.
+     *
+     * @param outra A lista cujos itens serão anexados ao fim desta.
+     */
+    virtual void concatenar(ListaEncadeadaAbstrata<T>& outra)
+    {
+        if (&outra == this || outra.vazia())
+        {
+            return;
+        }
+
+        MinhaListaEncadeada<T> *minha_outra = dynamic_cast<MinhaListaEncadeada<T> *>(&outra);
+
+        if (minha_outra != nullptr)
+        {
+            /**
+             * encadeia o primeiro elemento da outra lista apos o ultimo desta,
+             * sem copiar nem realocar elementos
+             */
+            if (!vazia())
+            {
+                this->_ultimo->proximo = minha_outra->_primeiro;
+                minha_outra->_primeiro->anterior = this->_ultimo;
+            }
+            else
+            {
+                this->_primeiro = minha_outra->_primeiro;
+            }
+
+            this->_ultimo = minha_outra->_ultimo;
+            this->_tamanho += minha_outra->_tamanho;
+
+            minha_outra->_primeiro = nullptr;
+            minha_outra->_ultimo = nullptr;
+            minha_outra->_tamanho = 0;
+        }
+        else // outra implementacao: move item a item
+        {
+            while (!outra.vazia())
+            {
+                inserirNoFim(outra.removerDoInicio());
+            }
+        }
+    };
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,252 @@
+#ifndef DEC0006_POOL_DE_THREADS_H
+#define DEC0006_POOL_DE_THREADS_H
+
+#include <atomic>
+// std::atomic
+#include <condition_variable>
+// std::condition_variable
+#include <cstddef>
+// std::size_t
+#include <deque>
+// std::deque
+#include <exception>
+// std::exception_ptr
+#include <functional>
+// std::function
+#include <mutex>
+// std::mutex
+#include <thread>
+// std::thread
+#include <vector>
+// std::vector
+
+/**
+ * @brief Um conjunto fixo de threads que executa tarefas de divisao e
+ * conquista (fork-join). Enquanto espera por uma tarefa que delegou, a thread
+ * que chamou emParalelo executa outras tarefas pendentes, de modo que tarefas
+ * aninhadas nunca bloqueiam o pool.
+ *
+ */
+class PoolDeThreads
+{
+public:
+    /**
+     * @brief Constroi o pool e inicia suas threads.
+     *
+     * @param quantidade A quantidade de threads auxiliares. Por padrao, uma a
+     * menos que a quantidade de nucleos, ja que a thread que chama emParalelo
+     * tambem trabalha.
+     */
+    explicit PoolDeThreads(std::size_t quantidade = quantidadePadrao());
+
+    PoolDeThreads(PoolDeThreads const&) = delete;
+    PoolDeThreads& operator=(PoolDeThreads const&) = delete;
+
+    /**
+     * @brief Espera as threads terminarem suas tarefas atuais e as encerra.
+     *
+     */
+    ~PoolDeThreads();
+
+    /**
+     * @brief Executa duas funcoes, possivelmente em paralelo, e retorna
+     * quando ambas terminarem. Se alguma lancar uma excecao, ela e relancada
+     * apos as duas terminarem.
+     *
+     * @param primeira Funcao executada pela thread atual.
+     * @param segunda Funcao oferecida as threads do pool.
+     */
+    template<typename F, typename G>
+    void emParalelo(F&& primeira, G&& segunda);
+
+    /**
+     * @brief Obtem a quantidade de threads auxiliares do pool.
+     *
+     */
+    std::size_t quantidade() const;
+
+    /**
+     * @brief Obtem um pool compartilhado, criado no primeiro uso.
+     *
+     */
+    static PoolDeThreads& padrao();
+
+private:
+    struct Tarefa
+    {
+        std::function<void()> executar;
+        std::atomic<bool> concluida{false};
+        std::exception_ptr erro;
+    };
+
+    static std::size_t quantidadePadrao();
+
+    /**
+     * @brief Executa a tarefa mais recente da fila, se houver alguma.
+     *
+     * @return true se alguma tarefa foi executada.
+     */
+    bool executarPendente();
+
+    static void executar(Tarefa& tarefa);
+
+    void trabalhar();
+
+    std::vector<std::thread> _threads;
+    std::deque<Tarefa*> _fila;
+    std::mutex _mutex;
+    std::condition_variable _temTarefa;
+    bool _encerrando{false};
+};
+
+inline PoolDeThreads::PoolDeThreads(std::size_t const quantidade)
+{
+    for (std::size_t i = 0; i < quantidade; i++)
+    {
+        _threads.emplace_back([this] { trabalhar(); });
+    }
+}
+
+inline PoolDeThreads::~PoolDeThreads()
+{
+    {
+        std::lock_guard<std::mutex> trava{_mutex};
+        _encerrando = true;
+    }
+
+    _temTarefa.notify_all();
+
+    for (std::thread& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+template<typename F, typename G>
+void PoolDeThreads::emParalelo(F&& primeira, G&& segunda)
+{
+    if (_threads.empty())
+    {
+        primeira();
+        segunda();
+        return;
+    }
+
+    Tarefa tarefa;
+    tarefa.executar = [&segunda] { segunda(); };
+
+    {
+        std::lock_guard<std::mutex> trava{_mutex};
+        _fila.push_back(&tarefa);
+    }
+
+    _temTarefa.notify_one();
+
+    std::exception_ptr erro;
+
+    try
+    {
+        primeira();
+    }
+    catch (...)
+    {
+        erro = std::current_exception();
+    }
+
+    // a tarefa referencia variaveis desta pilha: so retorna apos ela terminar
+    while (!tarefa.concluida.load(std::memory_order_acquire))
+    {
+        if (!executarPendente())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (erro)
+    {
+        std::rethrow_exception(erro);
+    }
+
+    if (tarefa.erro)
+    {
+        std::rethrow_exception(tarefa.erro);
+    }
+}
+
+inline std::size_t PoolDeThreads::quantidade() const
+{
+    return _threads.size();
+}
+
+inline PoolDeThreads& PoolDeThreads::padrao()
+{
+    static PoolDeThreads pool;
+    return pool;
+}
+
+inline std::size_t PoolDeThreads::quantidadePadrao()
+{
+    unsigned const nucleos{std::thread::hardware_concurrency()};
+    return (nucleos > 1) ? nucleos - 1 : 0;
+}
+
+inline bool PoolDeThreads::executarPendente()
+{
+    Tarefa* tarefa;
+
+    {
+        std::lock_guard<std::mutex> trava{_mutex};
+
+        if (_fila.empty())
+        {
+            return false;
+        }
+
+        // a tarefa mais recente e a menor e, em geral, a que a thread atual espera
+        tarefa = _fila.back();
+        _fila.pop_back();
+    }
+
+    executar(*tarefa);
+    return true;
+}
+
+inline void PoolDeThreads::executar(Tarefa& tarefa)
+{
+    try
+    {
+        tarefa.executar();
+    }
+    catch (...)
+    {
+        tarefa.erro = std::current_exception();
+    }
+
+    tarefa.concluida.store(true, std::memory_order_release);
+}
+
+inline void PoolDeThreads::trabalhar()
+{
+    while (true)
+    {
+        Tarefa* tarefa;
+
+        {
+            std::unique_lock<std::mutex> trava{_mutex};
+            _temTarefa.wait(trava, [this] { return _encerrando || !_fila.empty(); });
+
+            if (_fila.empty())
+            {
+                return;
+            }
+
+            // as threads auxiliares pegam as tarefas mais antigas, que sao as maiores
+            tarefa = _fila.front();
+            _fila.pop_front();
+        }
+
+        executar(*tarefa);
+    }
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef RETRATO_AVL_HPP
+#define RETRATO_AVL_HPP
+
+#include "excecoes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Formato dos retratos (snapshots) binarios de uma ArvoreAVL, gravados por salvar() e lidos
+ * por carregar(), na ordem de bytes da maquina:
+ * - cabecalho: a assinatura "AVLT", a versao do formato, o tamanho de cada chave (0 se as
+ *   chaves sao gravadas por um serializador proprio), 4 bytes reservados e a quantidade de
+ *   chaves, com 8 bytes;
+ * - as chaves em ordem, repetidas conforme a contagem de cada nodo;
+ * - a soma de verificacao de tudo o que veio antes, com 8 bytes.
+ */
+namespace retrato
+{
+    constexpr char assinatura[4]{'A', 'V', 'L', 'T'};
+    constexpr std::uint32_t versao{1};
+
+    /**
+     * @brief tamanho do buffer das escritas e leituras no fluxo
+     */
+    constexpr std::size_t tamanhoDoBuffer{std::size_t{1} << 20};
+}
+
+/**
+ * @brief Soma de verificacao de 64 bits de uma sequencia de bytes, que pode ser entregue em
+ * pedacos de qualquer tamanho. Usa a rodada do xxHash64 em quatro acumuladores independentes,
+ * que consomem 32 bytes por vez sem esperar um pelo outro.
+ */
+class SomaDeVerificacao
+{
+    static constexpr std::uint64_t primo1{0x9E3779B185EBCA87ULL};
+    static constexpr std::uint64_t primo2{0xC2B2AE3D27D4EB4FULL};
+    static constexpr std::size_t tamanhoDoBloco{32};
+
+    std::uint64_t acumuladores[4]{primo1 + primo2, primo2, 0, 0 - primo1};
+    unsigned char pendentes[tamanhoDoBloco];
+    std::size_t quantidadePendente{0};
+    std::uint64_t total{0};
+
+public:
+    /**
+     * @brief Acrescenta bytes a sequencia
+     * @param dados inicio dos bytes
+     * @param bytes quantidade de bytes
+     */
+    void acumular(void const *dados, std::size_t bytes)
+    {
+        unsigned char const *atual = static_cast<unsigned char const *>(dados);
+        total += bytes;
+
+        if (quantidadePendente > 0)
+        {
+            std::size_t faltam = std::min(tamanhoDoBloco - quantidadePendente, bytes);
+            std::memcpy(pendentes + quantidadePendente, atual, faltam);
+            quantidadePendente += faltam;
+            atual += faltam;
+            bytes -= faltam;
+
+            if (quantidadePendente < tamanhoDoBloco)
+            {
+                return;
+            }
+
+            consomeBloco(pendentes);
+            quantidadePendente = 0;
+        }
+
+        for (; bytes >= tamanhoDoBloco; atual += tamanhoDoBloco, bytes -= tamanhoDoBloco)
+        {
+            consomeBloco(atual);
+        }
+
+        std::memcpy(pendentes, atual, bytes);
+        quantidadePendente = bytes;
+    }
+
+    /**
+     * @brief Calcula a soma dos bytes acumulados ate agora
+     * @return Soma de verificacao da sequencia
+     */
+    std::uint64_t valor() const
+    {
+        SomaDeVerificacao copia = *this;
+
+        if (copia.quantidadePendente > 0)
+        {
+            std::memset(copia.pendentes + copia.quantidadePendente, 0, tamanhoDoBloco - copia.quantidadePendente);
+            copia.consomeBloco(copia.pendentes);
+        }
+
+        std::uint64_t soma = rotaciona(copia.acumuladores[0], 1) + rotaciona(copia.acumuladores[1], 7) +
+                             rotaciona(copia.acumuladores[2], 12) + rotaciona(copia.acumuladores[3], 18);
+        soma ^= total;
+
+        // espalha cada bit da soma por todos os outros
+        soma ^= soma >> 33;
+        soma *= primo2;
+        soma ^= soma >> 29;
+        soma *= primo1;
+        soma ^= soma >> 32;
+        return soma;
+    }
+
+private:
+    static std::uint64_t rotaciona(std::uint64_t x, int bits)
+    {
+        return (x << bits) | (x >> (64 - bits));
+    }
+
+    void consomeBloco(unsigned char const *bloco)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            std::uint64_t palavra;
+            std::memcpy(&palavra, bloco + 8 * i, sizeof(palavra));
+            acumuladores[i] = rotaciona(acumuladores[i] + palavra * primo2, 31) * primo1;
+        }
+    }
+};
+
+/**
+ * @brief Grava bytes em um fluxo por meio de um buffer, em escritas grandes, acumulando a soma
+ * de verificacao do que e gravado. Erros de escrita ficam registrados no estado do fluxo.
+ */
+class EscritorDeRetrato
+{
+    std::ostream& saida;
+    std::vector<char> buffer;
+    std::size_t usados{0};
+    SomaDeVerificacao soma;
+
+public:
+    explicit EscritorDeRetrato(std::ostream& saida):
+        saida{saida}, buffer(retrato::tamanhoDoBuffer)
+    {}
+
+    EscritorDeRetrato(EscritorDeRetrato const&) = delete;
+    EscritorDeRetrato& operator=(EscritorDeRetrato const&) = delete;
+
+    /**
+     * @brief Grava bytes no retrato
+     * @param dados inicio dos bytes
+     * @param bytes quantidade de bytes
+     */
+    void escrever(void const *dados, std::size_t bytes)
+    {
+        if (bytes > buffer.size() - usados)
+        {
+            esvaziar();
+
+            if (bytes >= buffer.size())
+            {
+                soma.acumular(dados, bytes);
+                saida.write(static_cast<char const *>(dados), static_cast<std::streamsize>(bytes));
+                return;
+            }
+        }
+
+        std::memcpy(buffer.data() + usados, dados, bytes);
+        usados += bytes;
+    }
+
+    /**
+     * @brief Grava um valor trivialmente copiavel, como os campos do cabecalho
+     */
+    template <typename U>
+    void escreverValor(U const& valor)
+    {
+        static_assert(std::is_trivially_copyable_v<U>, "apenas tipos trivialmente copiaveis");
+        escrever(&valor, sizeof(U));
+    }
+
+    /**
+     * @brief Grava a soma de verificacao de todos os bytes gravados e esvazia o buffer
+     */
+    void finalizar()
+    {
+        esvaziar();
+
+        std::uint64_t valor = soma.valor();
+        saida.write(reinterpret_cast<char const *>(&valor), sizeof(valor));
+        saida.flush();
+    }
+
+private:
+    void esvaziar()
+    {
+        soma.acumular(buffer.data(), usados);
+        saida.write(buffer.data(), static_cast<std::streamsize>(usados));
+        usados = 0;
+    }
+};
+
+/**
+ * @brief Le bytes de um fluxo por meio de um buffer, em leituras grandes, acumulando a soma de
+ * verificacao do que e lido. Lanca ExcecaoRetratoInvalido se o fluxo termina antes do esperado.
+ */
+class LeitorDeRetrato
+{
+    std::istream& entrada;
+    std::vector<char> buffer;
+    std::size_t posicao{0};
+    std::size_t disponiveis{0};
+    SomaDeVerificacao soma;
+
+public:
+    explicit LeitorDeRetrato(std::istream& entrada):
+        entrada{entrada}, buffer(retrato::tamanhoDoBuffer)
+    {}
+
+    LeitorDeRetrato(LeitorDeRetrato const&) = delete;
+    LeitorDeRetrato& operator=(LeitorDeRetrato const&) = delete;
+
+    /**
+     * @brief Le bytes do retrato. Leituras maiores que o buffer vao direto do fluxo para o
+     * destino, sem copia intermediaria.
+     * @param dados destino dos bytes
+     * @param bytes quantidade de bytes
+     */
+    void ler(void *dados, std::size_t bytes)
+    {
+        char *destino = static_cast<char *>(dados);
+
+        while (bytes > 0)
+        {
+            if (posicao == disponiveis)
+            {
+                if (bytes >= buffer.size())
+                {
+                    leDoFluxo(destino, bytes);
+                    soma.acumular(destino, bytes);
+                    return;
+                }
+
+                posicao = 0;
+                disponiveis = leDoFluxoAte(buffer.data(), buffer.size());
+            }
+
+            std::size_t copiados = std::min(bytes, disponiveis - posicao);
+            std::memcpy(destino, buffer.data() + posicao, copiados);
+            soma.acumular(destino, copiados);
+            posicao += copiados;
+            destino += copiados;
+            bytes -= copiados;
+        }
+    }
+
+    /**
+     * @brief Le um valor trivialmente copiavel, como os campos do cabecalho
+     */
+    template <typename U>
+    U lerValor()
+    {
+        static_assert(std::is_trivially_copyable_v<U>, "apenas tipos trivialmente copiaveis");
+        U valor;
+        ler(&valor, sizeof(U));
+        return valor;
+    }
+
+    /**
+     * @brief Le a soma de verificacao gravada ao fim do retrato e a compara com a dos bytes
+     * lidos ate agora
+     */
+    void verificarSoma()
+    {
+        std::uint64_t esperada = soma.valor();
+
+        if (lerValor<std::uint64_t>() != esperada)
+        {
+            throw ExcecaoRetratoInvalido{"soma de verificacao incorreta"};
+        }
+    }
+
+private:
+    void leDoFluxo(char *destino, std::size_t bytes)
+    {
+        if (leDoFluxoAte(destino, bytes) != bytes)
+        {
+            throw ExcecaoRetratoInvalido{"retrato truncado"};
+        }
+    }
+
+    /**
+     * @brief le ate @param bytes bytes; le menos apenas se o fluxo termina, e pelo menos um
+     */
+    std::size_t leDoFluxoAte(char *destino, std::size_t bytes)
+    {
+        entrada.read(destino, static_cast<std::streamsize>(bytes));
+        std::size_t lidos = static_cast<std::size_t>(entrada.gcount());
+
+        if (lidos == 0)
+        {
+            throw ExcecaoRetratoInvalido{"retrato truncado"};
+        }
+
+        return lidos;
+    }
+};
+
+/**
+ * @brief Serializador padrao dos retratos, para chaves trivialmente copiaveis: cada chave e
+ * gravada byte a byte, e a leitura das chaves e uma unica copia do fluxo para um vetor.
+ *
+ * Para outros tipos, salvar() e carregar() recebem um serializador com os metodos
+ * void escrever(T const& chave, EscritorDeRetrato& escritor) e
+ * T ler(LeitorDeRetrato& leitor).
+ */
+template <typename T>
+struct SerializadorTrivial
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "chaves que nao sao trivialmente copiaveis precisam de um serializador proprio");
+
+    void escrever(T const& chave, EscritorDeRetrato& escritor) const
+    {
+        escritor.escreverValor(chave);
+    }
+
+    T ler(LeitorDeRetrato& leitor) const
+    {
+        return leitor.lerValor<T>();
+    }
+};
+
+#endif
@@ -0,0 +1,750 @@
+#include "ArvoreAVLCompacta.h"
+#include "MinhaArvoreAVL.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Relogio = std::chrono::steady_clock;
+
+/**
+ * Todas as alocacoes do programa passam pelos operadores abaixo, que contam
+ * os bytes vivos para estimar o consumo de memoria por chave de cada
+ * estrutura. Cada bloco guarda seu tamanho em um cabecalho.
+ */
+static std::atomic<std::size_t> bytesVivos{0};
+
+static constexpr std::size_t cabecalho{alignof(std::max_align_t)};
+
+void* operator new(std::size_t tamanho)
+{
+    void* bloco{std::malloc(tamanho + cabecalho)};
+    if (bloco == nullptr)
+        throw std::bad_alloc{};
+
+    *static_cast<std::size_t*>(bloco) = tamanho;
+    bytesVivos += tamanho;
+    return static_cast<unsigned char*>(bloco) + cabecalho;
+}
+
+void operator delete(void* ponteiro) noexcept
+{
+    if (ponteiro == nullptr)
+        return;
+
+    void* bloco{static_cast<unsigned char*>(ponteiro) - cabecalho};
+    bytesVivos -= *static_cast<std::size_t*>(bloco);
+    std::free(bloco);
+}
+
+void* operator new[](std::size_t tamanho)
+{
+    return operator new(tamanho);
+}
+
+void operator delete[](void* ponteiro) noexcept
+{
+    operator delete(ponteiro);
+}
+
+void operator delete(void* ponteiro, std::size_t) noexcept
+{
+    operator delete(ponteiro);
+}
+
+void operator delete[](void* ponteiro, std::size_t) noexcept
+{
+    operator delete(ponteiro);
+}
+
+// o indice congelado aloca suas chaves alinhadas a linha de cache
+void* operator new(std::size_t tamanho, std::align_val_t alinhamento)
+{
+    std::size_t const deslocamento{std::max(cabecalho, static_cast<std::size_t>(alinhamento))};
+    std::size_t const total{(tamanho + deslocamento + deslocamento - 1) / deslocamento * deslocamento};
+    void* bloco{std::aligned_alloc(static_cast<std::size_t>(alinhamento), total)};
+    if (bloco == nullptr)
+        throw std::bad_alloc{};
+
+    *static_cast<std::size_t*>(bloco) = tamanho;
+    bytesVivos += tamanho;
+    return static_cast<unsigned char*>(bloco) + deslocamento;
+}
+
+void operator delete(void* ponteiro, std::align_val_t alinhamento) noexcept
+{
+    if (ponteiro == nullptr)
+        return;
+
+    std::size_t const deslocamento{std::max(cabecalho, static_cast<std::size_t>(alinhamento))};
+    void* bloco{static_cast<unsigned char*>(ponteiro) - deslocamento};
+    bytesVivos -= *static_cast<std::size_t*>(bloco);
+    std::free(bloco);
+}
+
+/**
+ * @brief Gera indices de 0 a n - 1 com distribuicao de Zipf (expoente 0.99),
+ * pelo metodo de Gray et al. usado no YCSB: O(n) para preparar e O(1) por
+ * indice.
+ */
+class GeradorZipf
+{
+public:
+    explicit GeradorZipf(std::uint64_t n, double teta = 0.99):
+        _n{n},
+        _teta{teta}
+    {
+        double zeta_2{0};
+        for (std::uint64_t i = 1; i <= n; i++)
+        {
+            _zeta_n += 1.0 / std::pow(static_cast<double>(i), teta);
+            if (i == 2)
+                zeta_2 = _zeta_n;
+        }
+
+        _alfa = 1.0 / (1.0 - teta);
+        _eta = (1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - teta)) / (1.0 - zeta_2 / _zeta_n);
+    }
+
+    template <typename Gerador>
+    std::uint64_t operator()(Gerador& gerador)
+    {
+        double const u{std::uniform_real_distribution<double>{0.0, 1.0}(gerador)};
+        double const uz{u * _zeta_n};
+
+        if (uz < 1.0)
+            return 0;
+        if (uz < 1.0 + std::pow(0.5, _teta))
+            return 1;
+
+        std::uint64_t const indice{static_cast<std::uint64_t>(static_cast<double>(_n) * std::pow(_eta * u - _eta + 1.0, _alfa))};
+        return (indice < _n) ? indice : _n - 1;
+    }
+
+private:
+    std::uint64_t _n;
+    double _teta;
+    double _zeta_n{0};
+    double _alfa;
+    double _eta;
+};
+
+/**
+ * @brief Espalha os indices pelo dominio das chaves, para que as chaves mais
+ * frequentes do padrao zipf nao sejam tambem as menores.
+ */
+static std::uint64_t espalha(std::uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief Converte um numero para cada tipo de chave medido.
+ */
+template <typename T>
+static T chaveDe(std::uint64_t x);
+
+template <>
+int chaveDe<int>(std::uint64_t x)
+{
+    return static_cast<int>(x);
+}
+
+template <>
+std::int64_t chaveDe<std::int64_t>(std::uint64_t x)
+{
+    return static_cast<std::int64_t>(x);
+}
+
+template <>
+std::string chaveDe<std::string>(std::uint64_t x)
+{
+    // 20 digitos: maior que o buffer de strings curtas, como chaves reais costumam ser
+    char texto[24];
+    std::snprintf(texto, sizeof(texto), "%020llu", static_cast<unsigned long long>(x));
+    return texto;
+}
+
+/**
+ * @brief Gera n chaves do padrao dado: sequencial (crescente), aleatorio
+ * (uniforme, praticamente sem repeticoes) ou zipf (muitas repeticoes das
+ * chaves mais frequentes).
+ */
+template <typename T>
+static std::vector<T> geraChaves(std::string const& padrao, std::size_t n)
+{
+    std::vector<T> chaves;
+    chaves.reserve(n);
+    std::mt19937_64 gerador{n};
+
+    if (padrao == "sequencial")
+    {
+        for (std::size_t i = 0; i < n; i++)
+            chaves.push_back(chaveDe<T>(i));
+    }
+    else if (padrao == "aleatorio")
+    {
+        for (std::size_t i = 0; i < n; i++)
+            chaves.push_back(chaveDe<T>(gerador() >> 34));
+    }
+    else
+    {
+        GeradorZipf zipf{n};
+        for (std::size_t i = 0; i < n; i++)
+            chaves.push_back(chaveDe<T>(espalha(zipf(gerador)) >> 34));
+    }
+
+    return chaves;
+}
+
+/**
+ * @brief Adaptadores que dao a ArvoreAVL e aos conjuntos da biblioteca
+ * padrao a mesma interface no benchmark.
+ */
+template <typename T, template <typename> class Alocador, bool ContaRepeticoes = false>
+struct Avl
+{
+    ArvoreAVL<T, Alocador, std::less<T>, ContaRepeticoes> arvore;
+
+    void inserir(T const& chave) { arvore.inserir(chave); }
+    bool contem(T const& chave) const { return arvore.contem(chave); }
+    void remover(T const& chave) { arvore.remover(chave); }
+
+    std::size_t emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T>* lista{arvore.emOrdem()};
+        std::size_t const tamanho{lista->tamanho()};
+        delete lista;
+        return tamanho;
+    }
+};
+
+// a arvore com nodos compactos: indices de 32 bits e fator de balanceamento em 2 bits
+template <typename T>
+struct AvlCompacta
+{
+    ArvoreAVLCompacta<T> arvore;
+
+    void inserir(T const& chave) { arvore.inserir(chave); }
+    bool contem(T const& chave) const { return arvore.contem(chave); }
+    void remover(T const& chave) { arvore.remover(chave); }
+
+    std::size_t emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T>* lista{arvore.emOrdem()};
+        std::size_t const tamanho{lista->tamanho()};
+        delete lista;
+        return tamanho;
+    }
+};
+
+// a mesma arvore usada por um ponteiro para a interface, com chamadas virtuais
+template <typename T>
+struct AvlPelaInterface
+{
+    ArvoreBinariaDeBusca<T>* arvore{new MinhaArvoreAVL<T>};
+
+    AvlPelaInterface() = default;
+    AvlPelaInterface(AvlPelaInterface const&) = delete;
+    AvlPelaInterface& operator=(AvlPelaInterface const&) = delete;
+
+    ~AvlPelaInterface() { delete arvore; }
+
+    void inserir(T const& chave) { arvore->inserir(chave); }
+    bool contem(T const& chave) const { return arvore->contem(chave); }
+    void remover(T const& chave) { arvore->remover(chave); }
+
+    std::size_t emOrdem() const
+    {
+        ListaEncadeadaAbstrata<T>* lista{arvore->emOrdem()};
+        std::size_t const tamanho{lista->tamanho()};
+        delete lista;
+        return tamanho;
+    }
+};
+
+template <typename Conjunto>
+struct DaBiblioteca
+{
+    using T = typename Conjunto::key_type;
+
+    Conjunto conjunto;
+
+    void inserir(T const& chave) { conjunto.insert(chave); }
+    bool contem(T const& chave) const { return conjunto.find(chave) != conjunto.end(); }
+
+    // como a arvore, remove uma unica ocorrencia da chave
+    void remover(T const& chave)
+    {
+        auto posicao = conjunto.find(chave);
+        if (posicao != conjunto.end())
+            conjunto.erase(posicao);
+    }
+
+    // como a arvore, copia as chaves em ordem para uma lista encadeada
+    std::size_t emOrdem() const
+    {
+        std::list<T> lista(conjunto.begin(), conjunto.end());
+        return lista.size();
+    }
+};
+
+/**
+ * @brief Contagens medias por operacao de uma arvore que coleta estatisticas;
+ * as linhas que nao as medem deixam as colunas vazias
+ */
+struct Contagens
+{
+    double nodosPorOperacao{-1};
+    double subidasPorOperacao{-1};
+};
+
+/**
+ * @brief Imprime uma linha do CSV. A vazao e de n operacoes, a menos que
+ * outra quantidade de operacoes seja dada.
+ */
+static void imprime(char const* estrutura, char const* tipo, std::string const& padrao, std::size_t n,
+                    char const* operacao, double segundos, double bytes_por_chave, std::size_t operacoes = 0,
+                    Contagens contagens = {})
+{
+    std::size_t const medidas{(operacoes != 0) ? operacoes : n};
+    std::printf("%s,%s,%s,%zu,%s,%.6f,%.0f,%.1f,", estrutura, tipo, padrao.c_str(), n, operacao, segundos,
+                (segundos > 0) ? static_cast<double>(medidas) / segundos : 0.0, bytes_por_chave);
+
+    if (contagens.nodosPorOperacao >= 0)
+        std::printf("%.2f,%.2f\n", contagens.nodosPorOperacao, contagens.subidasPorOperacao);
+    else
+        std::printf(",\n");
+}
+
+/**
+ * @brief Mede inserir, contem, emOrdem, a destruicao e remover de uma
+ * estrutura com as chaves dadas. A memoria por chave e medida com a
+ * estrutura cheia.
+ */
+template <typename Estrutura, typename T>
+static void mede(char const* estrutura, char const* tipo, std::string const& padrao, std::vector<T> const& chaves)
+{
+    std::size_t const n{chaves.size()};
+    std::size_t const bytes_antes{bytesVivos};
+
+    Relogio::time_point inicio{Relogio::now()};
+
+    Estrutura* cheia{new Estrutura};
+    for (T const& chave : chaves)
+        cheia->inserir(chave);
+
+    Relogio::time_point fim{Relogio::now()};
+    double const bytes_por_chave{static_cast<double>(bytesVivos - bytes_antes) / static_cast<double>(n)};
+    imprime(estrutura, tipo, padrao, n, "inserir", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    inicio = Relogio::now();
+
+    std::size_t encontradas{0};
+    for (T const& chave : chaves)
+        encontradas += cheia->contem(chave);
+
+    fim = Relogio::now();
+    if (encontradas != n)
+        std::abort();
+    imprime(estrutura, tipo, padrao, n, "contem", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    inicio = Relogio::now();
+    std::size_t const visitadas{cheia->emOrdem()};
+    fim = Relogio::now();
+    imprime(estrutura, tipo, padrao, visitadas, "emOrdem", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    inicio = Relogio::now();
+    delete cheia;
+    fim = Relogio::now();
+    imprime(estrutura, tipo, padrao, n, "destruir", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    Estrutura* removida{new Estrutura};
+    for (T const& chave : chaves)
+        removida->inserir(chave);
+
+    inicio = Relogio::now();
+
+    for (T const& chave : chaves)
+        removida->remover(chave);
+
+    fim = Relogio::now();
+    imprime(estrutura, tipo, padrao, n, "remover", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    delete removida;
+}
+
+/**
+ * @brief Mede congelar e as consultas do indice congelado, para comparar com
+ * as linhas da arvore de ponteiros.
+ */
+template <typename T>
+static void medeCongelada(char const* tipo, std::string const& padrao, std::vector<T> const& chaves)
+{
+    std::size_t const n{chaves.size()};
+    MinhaArvoreAVL<T> arvore;
+    for (T const& chave : chaves)
+        arvore.inserir(chave);
+
+    std::size_t const bytes_antes{bytesVivos};
+    Relogio::time_point inicio{Relogio::now()};
+    ArvoreCongelada<T> const congelada{arvore.congelar()};
+    Relogio::time_point fim{Relogio::now()};
+    double const bytes_por_chave{static_cast<double>(bytesVivos - bytes_antes) / static_cast<double>(n)};
+    imprime("congelada", tipo, padrao, n, "congelar", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    inicio = Relogio::now();
+
+    std::size_t encontradas{0};
+    for (T const& chave : chaves)
+        encontradas += congelada.contem(chave);
+
+    fim = Relogio::now();
+    if (encontradas != n)
+        std::abort();
+    imprime("congelada", tipo, padrao, n, "contem", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+
+    inicio = Relogio::now();
+    ListaEncadeadaAbstrata<T>* lista{congelada.emOrdem()};
+    fim = Relogio::now();
+    imprime("congelada", tipo, padrao, lista->tamanho(), "emOrdem", std::chrono::duration<double>(fim - inicio).count(), bytes_por_chave);
+    delete lista;
+}
+
+/**
+ * @brief Mede todas as estruturas com um tipo de chave, em todos os padroes.
+ */
+template <typename T>
+static void medeTipo(char const* tipo, std::size_t n)
+{
+    for (std::string const padrao : {"sequencial", "aleatorio", "zipf"})
+    {
+        std::vector<T> const chaves{geraChaves<T>(padrao, n)};
+
+        mede<Avl<T, AlocadorSlab>>("avl", tipo, padrao, chaves);
+        mede<Avl<T, AlocadorNovo>>("avl_novo", tipo, padrao, chaves);
+        mede<Avl<T, AlocadorSlab, true>>("avl_contagem", tipo, padrao, chaves);
+        mede<AvlCompacta<T>>("avl_compacta", tipo, padrao, chaves);
+        mede<AvlPelaInterface<T>>("avl_interface", tipo, padrao, chaves);
+        mede<DaBiblioteca<std::set<T>>>("std_set", tipo, padrao, chaves);
+        mede<DaBiblioteca<std::multiset<T>>>("std_multiset", tipo, padrao, chaves);
+        medeCongelada<T>(tipo, padrao, chaves);
+    }
+}
+
+/**
+ * @brief Compara a construcao a partir de chaves ordenadas com a insercao
+ * de uma chave por vez.
+ */
+static void medeConstrucao(std::size_t n)
+{
+    std::vector<int> chaves(n);
+    for (std::size_t i = 0; i < n; i++)
+        chaves[i] = static_cast<int>(i);
+
+    Relogio::time_point const inicio{Relogio::now()};
+
+    ArvoreBinariaDeBusca<int>* arvore{new MinhaArvoreAVL<int>};
+    for (int const chave : chaves)
+        arvore->inserir(chave);
+
+    Relogio::time_point const meio{Relogio::now()};
+
+    ArvoreBinariaDeBusca<int>* construida{new MinhaArvoreAVL<int>(chaves.begin(), chaves.end())};
+
+    Relogio::time_point const fim{Relogio::now()};
+
+    imprime("avl", "int", "sequencial", n, "inserir_ordenado", std::chrono::duration<double>(meio - inicio).count(), 0);
+    imprime("avl", "int", "sequencial", n, "construir_ordenado", std::chrono::duration<double>(fim - meio).count(), 0);
+
+    delete arvore;
+    delete construida;
+}
+
+/**
+ * @brief Mede a uniao de duas arvores de n chaves intercaladas, sem threads
+ * auxiliares e com o pool padrao.
+ */
+static void medeUniao(std::size_t n)
+{
+    std::vector<int> pares(n);
+    std::vector<int> impares(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        pares[i] = static_cast<int>(2 * i);
+        impares[i] = static_cast<int>(2 * i + 1);
+    }
+
+    PoolDeThreads sequencial{0};
+    PoolDeThreads* pools[]{&sequencial, &PoolDeThreads::padrao()};
+
+    for (PoolDeThreads* pool : pools)
+    {
+        MinhaArvoreAVL<int> arvore(pares.begin(), pares.end());
+        MinhaArvoreAVL<int> outra(impares.begin(), impares.end());
+
+        Relogio::time_point const inicio{Relogio::now()};
+        arvore.unir(outra, *pool);
+        Relogio::time_point const fim{Relogio::now()};
+
+        std::string const operacao{"unir_" + std::to_string(pool->quantidade() + 1) + "_threads"};
+        imprime("avl", "int", "sequencial", n, operacao.c_str(), std::chrono::duration<double>(fim - inicio).count(), 0);
+    }
+}
+
+/**
+ * @brief Compara inserirLote com a insercao de uma chave por vez, para
+ * lotes aleatorios de n / 1000 a n chaves em uma arvore com n chaves. A
+ * vazao e de chaves do lote por segundo.
+ */
+static void medeLote(std::size_t n)
+{
+    std::vector<int> chaves{geraChaves<int>("aleatorio", n)};
+    std::sort(chaves.begin(), chaves.end());
+    chaves.erase(std::unique(chaves.begin(), chaves.end()), chaves.end());
+
+    for (std::size_t divisor : {1000, 100, 10, 1})
+    {
+        std::size_t const m{n / divisor};
+        if (m == 0)
+            continue;
+
+        std::vector<int> const lote{geraChaves<int>("aleatorio", m)};
+        std::string const razao{"_1/" + std::to_string(divisor)};
+
+        ArvoreAVL<int> por_chave(chaves.begin(), chaves.end());
+        ArvoreAVL<int> em_lote(chaves.begin(), chaves.end());
+
+        Relogio::time_point const inicio{Relogio::now()};
+        for (int const chave : lote)
+            por_chave.inserir(chave);
+        Relogio::time_point const meio{Relogio::now()};
+        em_lote.inserirLote(lote.begin(), lote.end());
+        Relogio::time_point const fim{Relogio::now()};
+
+        imprime("avl", "int", "aleatorio", n, ("inserir" + razao).c_str(),
+                std::chrono::duration<double>(meio - inicio).count(), 0, m);
+        imprime("avl", "int", "aleatorio", n, ("inserirLote" + razao).c_str(),
+                std::chrono::duration<double>(fim - meio).count(), 0, m);
+    }
+}
+
+/**
+ * @brief Mede quantos nodos cada insercao e remocao visita na descida e
+ * quantos passos sobe ate o pai ao corrigir alturas e tamanhos. Com os
+ * ponteiros para o pai, nenhuma rotacao volta a descer da raiz, e as
+ * visitas por operacao ficam proximas da profundidade media, cerca de
+ * log2(n).
+ */
+static void medeContagens(std::size_t n)
+{
+    std::vector<int> chaves{geraChaves<int>("aleatorio", n)};
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, false, true> arvore;
+
+    Relogio::time_point const inicio{Relogio::now()};
+    for (int const chave : chaves)
+        arvore.inserir(chave);
+    Relogio::time_point const meio{Relogio::now()};
+    EstatisticasAVL const insercoes{arvore.estatisticas()};
+
+    std::shuffle(chaves.begin(), chaves.end(), std::mt19937_64{11});
+    arvore.zerarEstatisticas();
+
+    Relogio::time_point const antes_de_remover{Relogio::now()};
+    for (int const chave : chaves)
+        arvore.remover(chave);
+    Relogio::time_point const fim{Relogio::now()};
+    EstatisticasAVL const remocoes{arvore.estatisticas()};
+
+    double const operacoes{static_cast<double>(n)};
+    imprime("avl_estatisticas", "int", "aleatorio", n, "inserir", std::chrono::duration<double>(meio - inicio).count(), 0,
+            0, {insercoes.comprimentoMedioDeBusca(), static_cast<double>(insercoes.subidasAoPai) / operacoes});
+    imprime("avl_estatisticas", "int", "aleatorio", n, "remover",
+            std::chrono::duration<double>(fim - antes_de_remover).count(), 0, 0,
+            {remocoes.comprimentoMedioDeBusca(), static_cast<double>(remocoes.subidasAoPai) / operacoes});
+}
+
+/**
+ * @brief Compara percorrer a arvore em ordem com emOrdem, que copia as chaves
+ * para uma lista, e com visitarEmOrdem, que chama uma funcao por chave. A
+ * memoria por chave e a alocada pelo percurso.
+ */
+static void medeVisita(std::size_t n)
+{
+    std::vector<int> const chaves{geraChaves<int>("aleatorio", n)};
+    ArvoreAVL<int> arvore;
+    for (int const chave : chaves)
+        arvore.inserir(chave);
+
+    std::size_t const bytes_antes{bytesVivos};
+    Relogio::time_point const inicio{Relogio::now()};
+
+    ListaEncadeadaAbstrata<int>* lista{arvore.emOrdem()};
+    std::size_t const bytes_lista{bytesVivos - bytes_antes};
+    delete lista;
+
+    Relogio::time_point const meio{Relogio::now()};
+
+    long long soma{0};
+    arvore.visitarEmOrdem([&soma](int const& chave) { soma += chave; });
+
+    Relogio::time_point const fim{Relogio::now()};
+    if (soma == 1)
+        std::abort();
+
+    imprime("avl", "int", "aleatorio", n, "emOrdem_lista", std::chrono::duration<double>(meio - inicio).count(),
+            static_cast<double>(bytes_lista) / static_cast<double>(n));
+    imprime("avl", "int", "aleatorio", n, "visitarEmOrdem", std::chrono::duration<double>(fim - meio).count(),
+            static_cast<double>(bytesVivos - bytes_antes) / static_cast<double>(n));
+}
+
+/**
+ * @brief Mede consultas de vizinhanca: a chave seguinte a chaves aleatorias e o esvaziamento
+ * da arvore pela menor chave, que le o extremo guardado em O(1) antes de cada remocao
+ */
+static void medeVizinhos(std::size_t n)
+{
+    std::vector<int> const chaves{geraChaves<int>("aleatorio", n)};
+    ArvoreAVL<int> arvore;
+    for (int const chave : chaves)
+        arvore.inserir(chave);
+
+    Relogio::time_point const inicio{Relogio::now()};
+
+    long long soma{0};
+    for (int const chave : chaves)
+        soma += arvore.sucessor(chave).value_or(0);
+
+    Relogio::time_point const meio{Relogio::now()};
+
+    for (std::optional<int> menor{arvore.minimo()}; menor.has_value(); menor = arvore.minimo())
+    {
+        soma += *menor;
+        arvore.remover(*menor);
+    }
+
+    Relogio::time_point const fim{Relogio::now()};
+    if (soma == 1)
+        std::abort();
+
+    imprime("avl", "int", "aleatorio", n, "sucessor", std::chrono::duration<double>(meio - inicio).count(), 0);
+    imprime("avl", "int", "aleatorio", n, "esvazia_pelo_minimo", std::chrono::duration<double>(fim - meio).count(), 0);
+}
+
+/**
+ * @brief Compara inserir com a insercao com dica para chaves em ordem
+ * crescente e quase ordenadas (cada chave atrasada ate 64 posicoes), como
+ * marcas de tempo. A dica e o iterador retornado pela insercao anterior.
+ */
+static void medeDica(std::size_t n)
+{
+    std::mt19937_64 gerador{7};
+    // chaves de 64 bits: com o passo 64, chaves int estourariam a partir de n = 2^31 / 64
+    std::vector<std::int64_t> crescentes(n);
+    std::vector<std::int64_t> quase_ordenadas(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        crescentes[i] = static_cast<std::int64_t>(i);
+        quase_ordenadas[i] = static_cast<std::int64_t>(64 * i) - static_cast<std::int64_t>(gerador() % 4096);
+    }
+
+    for (std::string const padrao : {"sequencial", "quase_ordenado"})
+    {
+        std::vector<std::int64_t> const& chaves{(padrao == "sequencial") ? crescentes : quase_ordenadas};
+        ArvoreAVL<std::int64_t> sem_dica;
+        ArvoreAVL<std::int64_t> com_dica;
+        ArvoreAVL<std::int64_t>::Iterador dica{com_dica.end()};
+
+        Relogio::time_point const inicio{Relogio::now()};
+        for (std::int64_t const chave : chaves)
+            sem_dica.inserir(chave);
+        Relogio::time_point const meio{Relogio::now()};
+        for (std::int64_t const chave : chaves)
+            dica = com_dica.inserir(dica, chave);
+        Relogio::time_point const fim{Relogio::now()};
+
+        imprime("avl", "int64", padrao, n, "inserir", std::chrono::duration<double>(meio - inicio).count(), 0);
+        imprime("avl", "int64", padrao, n, "inserir_com_dica", std::chrono::duration<double>(fim - meio).count(), 0);
+    }
+}
+
+/**
+ * @brief Mede salvar e carregar um retrato binario de uma arvore com n
+ * chaves aleatorias, em memoria, sem o custo do disco. A vazao e de bytes
+ * do retrato por segundo.
+ */
+static void medeRetrato(std::size_t n)
+{
+    std::vector<int> chaves{geraChaves<int>("aleatorio", n)};
+    std::sort(chaves.begin(), chaves.end());
+    chaves.erase(std::unique(chaves.begin(), chaves.end()), chaves.end());
+
+    ArvoreAVL<int> arvore(chaves.begin(), chaves.end());
+    ArvoreAVL<int> carregada;
+    std::stringstream fluxo;
+
+    Relogio::time_point const inicio{Relogio::now()};
+    arvore.salvar(fluxo);
+    Relogio::time_point const meio{Relogio::now()};
+    carregada.carregar(fluxo);
+    Relogio::time_point const fim{Relogio::now()};
+
+    std::size_t const bytes{fluxo.str().size()};
+    imprime("avl", "int", "aleatorio", n, "salvar_bytes", std::chrono::duration<double>(meio - inicio).count(), 0, bytes);
+    imprime("avl", "int", "aleatorio", n, "carregar_bytes", std::chrono::duration<double>(fim - meio).count(), 0, bytes);
+}
+
+/**
+ * Uso: avl_bench [n_maximo [n_minimo]]
+ *
+ * Mede n = n_minimo, 10 n_minimo, ... ate n_maximo (por padrao, de 1e3 a
+ * 1e8) e imprime um CSV com uma linha por estrutura, tipo de chave, padrao,
+ * n e operacao. Chaves std::string sao medidas ate 1e7, pois com 1e8 as
+ * quatro estruturas nao cabem juntas na memoria de uma maquina comum.
+ */
+int main(int argc, char** argv)
+{
+    std::size_t const n_maximo{(argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000000};
+    std::size_t const n_minimo{(argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000};
+
+    std::printf("estrutura,tipo,padrao,n,operacao,segundos,ops_por_s,bytes_por_chave,nodos_por_op,subidas_por_op\n");
+
+    for (std::size_t n = n_minimo; n <= n_maximo; n *= 10)
+    {
+        medeTipo<int>("int", n);
+        medeTipo<std::int64_t>("int64", n);
+
+        if (n <= 10000000)
+            medeTipo<std::string>("string", n);
+
+        medeConstrucao(n);
+        medeUniao(n);
+        medeLote(n);
+        medeDica(n);
+        medeRetrato(n);
+        medeVisita(n);
+        medeContagens(n);
+        medeVizinhos(n);
+
+        std::fflush(stdout);
+    }
+
+    return 0;
+}
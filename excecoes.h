@@ -58,6 +58,22 @@ public:
     ExcecaoPosicaoInvalida();
 };
 
+/**
+ * @brief Exceção lançada caso se tente carregar uma arvore de um retrato binario corrompido,
+ * truncado ou gravado em outro formato.
+ * 
+ */
+class ExcecaoRetratoInvalido: public std::runtime_error
+{
+public:
+	/**
+	 * @brief Constrói uma ExcecaoRetratoInvalido.
+	 * 
+	 * @param motivo O problema encontrado no retrato.
+	 */
+	explicit ExcecaoRetratoInvalido(std::string const& motivo);
+};
+
 ExcecaoDadoInexistente::ExcecaoDadoInexistente():
     std::logic_error{"esse dado nao se encontra na lista"}
 {}
@@ -77,4 +93,8 @@ ExcecaoPosicaoInvalida::ExcecaoPosicaoInvalida():
     std::out_of_range{"posicao invalida na lista encadeada"}
 {}
 
+ExcecaoRetratoInvalido::ExcecaoRetratoInvalido(std::string const& motivo):
+	std::runtime_error{"retrato invalido: " + motivo}
+{}
+
 #endif
\ No newline at end of file
@@ -1,5 +1,69 @@
 #include "gtest/gtest.h"
 #include "MinhaArvoreAVL.h"
+#include "MeuMapaAVL.h"
+#include "ArvoreAVLCompacta.h"
+#include "ArvoreAVLConcorrente.h"
+#include "ArvoreAVLPersistente.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Verifica, pela interface publica, que a arvore contem exatamente as
+ * chaves (distintas) do conjunto e que toda subarvore respeita a altura e o
+ * fator de balanceamento AVL.
+ */
+static void verificaInvariantesAVL(ArvoreBinariaDeBusca<int> const* arvore, std::set<int> const& chaves)
+{
+    ASSERT_EQ(arvore->quantidade(), static_cast<int>(chaves.size()));
+
+    ListaEncadeadaAbstrata<int>* lista{arvore->emOrdem()};
+    ASSERT_EQ(lista->tamanho(), chaves.size());
+    for (int const e : chaves)
+        ASSERT_EQ(lista->removerDoInicio(), e);
+    delete lista;
+
+    int posicao{0};
+    for (int const e : chaves)
+    {
+        ASSERT_EQ(*arvore->selecionar(posicao), e);
+        ASSERT_EQ(arvore->rank(e), posicao);
+        posicao++;
+    }
+
+    for (int const e : chaves)
+    {
+        std::optional<int> const esquerda{arvore->filhoEsquerdaDe(e)};
+        std::optional<int> const direita{arvore->filhoDireitaDe(e)};
+        int const altura_esquerda{esquerda ? *arvore->altura(*esquerda) : -1};
+        int const altura_direita{direita ? *arvore->altura(*direita) : -1};
+
+        if (esquerda)
+        {
+            ASSERT_LT(*esquerda, e);
+        }
+        if (direita)
+        {
+            ASSERT_GT(*direita, e);
+        }
+
+        ASSERT_EQ(*arvore->altura(e), std::max(altura_esquerda, altura_direita) + 1);
+        ASSERT_LE(std::abs(altura_esquerda - altura_direita), 1);
+    }
+}
 
 TEST(ArvoreAVLTest, Inicializacao)
 {
@@ -413,6 +477,1305 @@ TEST(ArvoreAVLTest, RemocaoRotacaoDireitaEsquerda)
     delete arvore;
 }
 
+/**
+ * @brief Insere e remove chaves aleatorias, comparando a arvore com um std::set.
+ */
+static void testaInsercaoRemocaoAleatoria(ArvoreBinariaDeBusca<int>* const arvore)
+{
+    std::set<int> chaves;
+    std::mt19937 gerador{42};
+    std::uniform_int_distribution<int> distribuicao{0, 499};
+
+    for (int i = 0; i < 2000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+
+        if (chaves.count(chave))
+        {
+            arvore->remover(chave);
+            chaves.erase(chave);
+        }
+        else
+        {
+            arvore->inserir(chave);
+            chaves.insert(chave);
+        }
+
+        if (i % 100 == 0)
+            verificaInvariantesAVL(arvore, chaves);
+    }
+
+    verificaInvariantesAVL(arvore, chaves);
+
+    for (int const e : std::vector<int>(chaves.begin(), chaves.end()))
+    {
+        arvore->remover(e);
+        chaves.erase(e);
+    }
+
+    verificaInvariantesAVL(arvore, chaves);
+    ASSERT_TRUE(arvore->vazia());
+}
+
+TEST(ArvoreAVLTest, InsercaoRemocaoAleatoria)
+{
+    ArvoreBinariaDeBusca<int>* const arvore{new MinhaArvoreAVL<int>};
+    testaInsercaoRemocaoAleatoria(arvore);
+    delete arvore;
+}
+
+TEST(ArvoreAVLTest, AlocadorNovo)
+{
+    ArvoreBinariaDeBusca<int>* const arvore{new MinhaArvoreAVL<int, AlocadorNovo>};
+    testaInsercaoRemocaoAleatoria(arvore);
+    delete arvore;
+}
+
+TEST(ArvoreAVLTest, AlocadorSlabChavesComDestrutor)
+{
+    ArvoreBinariaDeBusca<std::string>* const arvore{new MinhaArvoreAVL<std::string>};
+
+    for (int i = 0; i < 1000; i++)
+        arvore->inserir("chave longa o bastante para alocar memoria " + std::to_string(i));
+
+    for (int i = 0; i < 1000; i += 2)
+        arvore->remover("chave longa o bastante para alocar memoria " + std::to_string(i));
+
+    // os espacos liberados sao reutilizados
+    for (int i = 0; i < 1000; i += 2)
+        arvore->inserir("outra chave longa o bastante para alocar " + std::to_string(i));
+
+    ASSERT_EQ(arvore->quantidade(), 1000);
+    ASSERT_TRUE(arvore->contem("chave longa o bastante para alocar memoria 1"));
+    ASSERT_TRUE(!arvore->contem("chave longa o bastante para alocar memoria 2"));
+
+    delete arvore;
+}
+
+TEST(ArvoreAVLTest, InsercaoRemocaoSequencial)
+{
+    ArvoreBinariaDeBusca<int>* const arvore{new MinhaArvoreAVL<int>};
+    int const n{100000};
+
+    for (int i = 0; i < n; i++)
+        arvore->inserir(i);
+
+    ASSERT_EQ(arvore->quantidade(), n);
+
+    // nenhuma subarvore excede a altura maxima de uma AVL com n chaves, 1.44 log2(n + 2)
+    for (int i = 0; i < n; i += 997)
+        ASSERT_LE(*arvore->altura(i), 24);
+
+    for (int i = 0; i < n; i += 2)
+        arvore->remover(i);
+
+    ASSERT_EQ(arvore->quantidade(), n / 2);
+    ASSERT_EQ(*arvore->selecionar(0), 1);
+    ASSERT_TRUE(!arvore->contem(n - 2));
+
+    for (int i = n - 1; i > 0; i -= 2)
+        arvore->remover(i);
+
+    ASSERT_TRUE(arvore->vazia());
+
+    delete arvore;
+}
+
+TEST(ArvoreAVLTest, EstatisticasDeOrdem)
+{
+    ArvoreBinariaDeBusca<int>* const arvore{new MinhaArvoreAVL<int>};
+
+    ASSERT_TRUE(!arvore->selecionar(0));
+    ASSERT_EQ(arvore->rank(10), 0);
+
+    for (int const e : {50, 20, 80, 10, 30, 70, 90, 60})
+        arvore->inserir(e);
+
+    ASSERT_EQ(arvore->quantidade(), 8);
+    ASSERT_EQ(*arvore->selecionar(0), 10);
+    ASSERT_EQ(*arvore->selecionar(4), 60);
+    ASSERT_EQ(*arvore->selecionar(7), 90);
+    ASSERT_TRUE(!arvore->selecionar(8));
+    ASSERT_TRUE(!arvore->selecionar(-1));
+
+    ASSERT_EQ(arvore->rank(10), 0);
+    ASSERT_EQ(arvore->rank(55), 4);
+    ASSERT_EQ(arvore->rank(60), 4);
+    ASSERT_EQ(arvore->rank(100), 8);
+
+    arvore->remover(50);
+    ASSERT_EQ(arvore->quantidade(), 7);
+    ASSERT_EQ(*arvore->selecionar(3), 60);
+    ASSERT_EQ(arvore->rank(60), 3);
+
+    delete arvore;
+}
+
+TEST(ArvoreAVLTest, Iteradores)
+{
+    MinhaArvoreAVL<int> arvore;
+
+    ASSERT_TRUE(arvore.begin() == arvore.end());
+    ASSERT_TRUE(arvore.rbegin() == arvore.rend());
+
+    for (int const e : {50, 20, 80, 10, 30, 70, 90, 60})
+        arvore.inserir(e);
+
+    std::vector<int> chaves;
+    for (int const e : arvore)
+        chaves.push_back(e);
+    ASSERT_EQ(chaves, (std::vector<int>{10, 20, 30, 50, 60, 70, 80, 90}));
+
+    std::vector<int> const reversas(arvore.rbegin(), arvore.rend());
+    ASSERT_EQ(reversas, (std::vector<int>{90, 80, 70, 60, 50, 30, 20, 10}));
+
+    ASSERT_EQ(std::distance(arvore.begin(), arvore.end()), 8);
+    ASSERT_EQ(*std::prev(arvore.end()), 90);
+    ASSERT_EQ(*std::find_if(arvore.begin(), arvore.end(), [](int e) { return e > 55; }), 60);
+
+    // iteradores para nodos que nao foram removidos continuam validos
+    MinhaArvoreAVL<int>::iterator it{std::find(arvore.begin(), arvore.end(), 60)};
+    arvore.remover(50);
+    arvore.remover(70);
+    ASSERT_EQ(*it, 60);
+    ASSERT_EQ(*--it, 30);
+    ASSERT_EQ(*++it, 60);
+    ASSERT_EQ(*++it, 80);
+}
+
+TEST(ArvoreAVLTest, ConsultaIntervalo)
+{
+    MinhaArvoreAVL<int> arvore;
+
+    ASSERT_EQ(arvore.contarIntervalo(0, 100), 0);
+
+    for (int i = 0; i < 100; i += 10)
+        arvore.inserir(i);
+
+    ASSERT_EQ(arvore.contarIntervalo(20, 50), 4);
+    ASSERT_EQ(arvore.contarIntervalo(15, 55), 4);
+    ASSERT_EQ(arvore.contarIntervalo(-5, 200), 10);
+    ASSERT_EQ(arvore.contarIntervalo(91, 200), 0);
+    ASSERT_EQ(arvore.contarIntervalo(50, 20), 0);
+
+    std::vector<int> visitadas;
+    arvore.visitarIntervalo(15, 55, [&](int e) { visitadas.push_back(e); });
+    ASSERT_EQ(visitadas, (std::vector<int>{20, 30, 40, 50}));
+
+    // o visitante pode interromper a visita retornando false
+    visitadas.clear();
+    arvore.visitarIntervalo(0, 90, [&](int e) { visitadas.push_back(e); return e < 20; });
+    ASSERT_EQ(visitadas, (std::vector<int>{0, 10, 20}));
+
+    auto const [primeiro, ultimo] = arvore.intervalo(35, 70);
+    ASSERT_EQ(std::vector<int>(primeiro, ultimo), (std::vector<int>{40, 50, 60, 70}));
+}
+
+TEST(ArvoreAVLTest, ConstrucaoDeOrdenado)
+{
+    std::vector<int> chaves;
+    for (int i = 0; i < 1000; i++)
+        chaves.push_back(2 * i);
+
+    MinhaArvoreAVL<int> arvore(chaves.begin(), chaves.end());
+    verificaInvariantesAVL(&arvore, std::set<int>(chaves.begin(), chaves.end()));
+
+    // arvore perfeitamente balanceada: altura minima para 1000 chaves
+    ASSERT_EQ(*arvore.altura(*arvore.selecionar(499)), 9);
+
+    // a arvore construida continua aceitando insercoes e remocoes
+    arvore.inserir(1);
+    arvore.remover(0);
+    ASSERT_EQ(*arvore.begin(), 1);
+
+    // reconstruir substitui o conteudo anterior
+    std::vector<int> const outras{3, 5, 7};
+    arvore.construirDeOrdenado(outras.begin(), outras.end());
+    ASSERT_EQ(std::vector<int>(arvore.begin(), arvore.end()), outras);
+    ASSERT_EQ(*arvore.filhoEsquerdaDe(5), 3);
+    ASSERT_EQ(*arvore.filhoDireitaDe(5), 7);
+
+    arvore.construirDeOrdenado(outras.end(), outras.end());
+    ASSERT_TRUE(arvore.vazia());
+}
+
+TEST(ArvoreAVLTest, InsercaoEmLote)
+{
+    std::mt19937 gerador{23};
+
+    // os lotes cobrem a insercao chave a chave, a uniao e a reconstrucao da arvore
+    for (int tamanho : {0, 1, 100, 5000})
+    {
+        for (int tamanho_lote : {0, 1, 10, 400, 20000})
+        {
+            std::uniform_int_distribution<int> distribuicao{0, 2 * (tamanho + tamanho_lote)};
+            MinhaArvoreAVL<int> arvore;
+            std::set<int> chaves;
+
+            for (int i = 0; i < tamanho; i++)
+            {
+                int const chave{distribuicao(gerador)};
+                if (chaves.insert(chave).second)
+                    arvore.inserir(chave);
+            }
+
+            std::vector<int> lote;
+            for (int i = 0; i < tamanho_lote; i++)
+                lote.push_back(distribuicao(gerador));
+
+            // o resultado e o mesmo de inserir as chaves uma a uma, com as repetidas
+            ArvoreAVL<int> uma_a_uma;
+            std::multiset<int> esperadas(chaves.begin(), chaves.end());
+            for (int const chave : chaves)
+                uma_a_uma.inserir(chave);
+            for (int const chave : lote)
+                uma_a_uma.inserir(chave);
+            esperadas.insert(lote.begin(), lote.end());
+
+            arvore.inserirLote(lote.begin(), lote.end());
+            ASSERT_EQ(arvore.quantidade(), uma_a_uma.quantidade());
+            ASSERT_TRUE(std::equal(arvore.begin(), arvore.end(), esperadas.begin(), esperadas.end()));
+
+            std::vector<int> const histograma{arvore.histogramaDeProfundidades()};
+            ASSERT_LE(static_cast<double>(histograma.size()), 1.45 * std::log2(esperadas.size() + 2.0) + 1);
+            std::vector<int> const ordenadas(esperadas.begin(), esperadas.end());
+            for (int const chave : lote)
+            {
+                ASSERT_EQ(arvore.rank(chave), std::lower_bound(ordenadas.begin(), ordenadas.end(), chave) - ordenadas.begin());
+            }
+        }
+    }
+}
+
+TEST(ArvoreAVLTest, DivisaoEJuncao)
+{
+    std::mt19937 gerador{7};
+    std::uniform_int_distribution<int> distribuicao{0, 9999};
+
+    for (int rodada = 0; rodada < 20; rodada++)
+    {
+        MinhaArvoreAVL<int> arvore;
+        std::set<int> chaves;
+
+        for (int i = 0; i < 300; i++)
+        {
+            int const chave{distribuicao(gerador)};
+            if (chaves.insert(chave).second)
+                arvore.inserir(chave);
+        }
+
+        int const corte{distribuicao(gerador)};
+        MinhaArvoreAVL<int> direita{arvore.dividir(corte)};
+
+        std::set<int> const menores(chaves.begin(), chaves.lower_bound(corte));
+        std::set<int> const maiores(chaves.lower_bound(corte), chaves.end());
+        verificaInvariantesAVL(&arvore, menores);
+        verificaInvariantesAVL(&direita, maiores);
+
+        // os ponteiros para os pais tambem foram refeitos
+        ASSERT_EQ(std::vector<int>(arvore.rbegin(), arvore.rend()), std::vector<int>(menores.rbegin(), menores.rend()));
+        ASSERT_EQ(std::vector<int>(direita.rbegin(), direita.rend()), std::vector<int>(maiores.rbegin(), maiores.rend()));
+
+        arvore.juntar(direita);
+        ASSERT_TRUE(direita.vazia());
+        verificaInvariantesAVL(&arvore, chaves);
+        ASSERT_EQ(std::vector<int>(arvore.rbegin(), arvore.rend()), std::vector<int>(chaves.rbegin(), chaves.rend()));
+    }
+}
+
+TEST(ArvoreAVLTest, JuncaoComChaveDoMeio)
+{
+    MinhaArvoreAVL<int> esquerda;
+    MinhaArvoreAVL<int> direita;
+    std::set<int> chaves;
+
+    // alturas bem diferentes exigem descer pela borda da arvore mais alta
+    for (int i = 0; i < 1000; i++)
+    {
+        esquerda.inserir(i);
+        chaves.insert(i);
+    }
+
+    for (int i = 2000; i < 2005; i++)
+    {
+        direita.inserir(i);
+        chaves.insert(i);
+    }
+
+    esquerda.juntar(1500, direita);
+    chaves.insert(1500);
+    ASSERT_TRUE(direita.vazia());
+    verificaInvariantesAVL(&esquerda, chaves);
+
+    // arvores cujos alocadores sao compartilhados com outras tambem podem ser juntadas
+    MinhaArvoreAVL<int> maiores{esquerda.dividir(1500)};
+    MinhaArvoreAVL<int> outra;
+    outra.inserir(-2);
+    outra.juntar(-1, esquerda);
+    outra.juntar(maiores);
+    chaves.insert(-2);
+    chaves.insert(-1);
+    verificaInvariantesAVL(&outra, chaves);
+
+    // juntar a uma arvore vazia
+    MinhaArvoreAVL<int> vazia;
+    vazia.juntar(-5, outra);
+    chaves.insert(-5);
+    verificaInvariantesAVL(&vazia, chaves);
+
+    // juntar a arvore a ela mesma nao perde chaves
+    vazia.juntar(5000, vazia);
+    vazia.juntar(vazia);
+    verificaInvariantesAVL(&vazia, chaves);
+}
+
+TEST(ArvoreAVLTest, Congelamento)
+{
+    std::mt19937 gerador{19};
+
+    for (int tamanho : {0, 1, 2, 7, 8, 100, 5000})
+    {
+        std::uniform_int_distribution<int> distribuicao{0, 2 * tamanho};
+        MinhaArvoreAVL<int> arvore;
+        std::multiset<int> chaves;
+
+        for (int i = 0; i < tamanho; i++)
+        {
+            int const chave{distribuicao(gerador)};
+            arvore.inserir(chave);
+            chaves.insert(chave);
+        }
+
+        ArvoreCongelada<int> const congelada{arvore.congelar()};
+        ASSERT_EQ(congelada.quantidade(), tamanho);
+
+        ListaEncadeadaAbstrata<int>* lista{congelada.emOrdem()};
+        for (int const e : chaves)
+            ASSERT_EQ(lista->removerDoInicio(), e);
+        ASSERT_TRUE(lista->vazia());
+        delete lista;
+
+        for (int chave = -1; chave <= 2 * tamanho + 1; chave++)
+        {
+            ASSERT_EQ(congelada.contem(chave), chaves.count(chave) > 0);
+
+            int const fim{chave + 3};
+            ASSERT_EQ(congelada.contarIntervalo(chave, fim), arvore.contarIntervalo(chave, fim));
+
+            std::vector<int> visitadas;
+            congelada.visitarIntervalo(chave, fim, [&](int const& e) { visitadas.push_back(e); });
+            ASSERT_EQ(visitadas, std::vector<int>(chaves.lower_bound(chave), chaves.upper_bound(fim)));
+        }
+    }
+
+    std::vector<std::string> const nomes{"ana", "bia", "caio", "davi"};
+    ArvoreCongelada<std::string> const congelada(nomes.begin(), nomes.end());
+    ASSERT_TRUE(congelada.contem("caio"));
+    ASSERT_FALSE(congelada.contem("beto"));
+    ASSERT_EQ(congelada.contarIntervalo("b", "d"), 2);
+}
+
+TEST(ArvoreAVLTest, ContagemDeRepeticoes)
+{
+    std::mt19937 gerador{29};
+    std::uniform_int_distribution<int> distribuicao{0, 15};
+
+    MinhaArvoreAVL<int, AlocadorSlab, std::less<int>, true> arvore;
+    std::multiset<int> chaves;
+
+    for (int i = 0; i < 20000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+
+        if (i % 3 == 2)
+        {
+            std::multiset<int>::iterator const encontrada{chaves.find(chave)};
+            ASSERT_EQ(arvore.contem(chave), encontrada != chaves.end());
+            arvore.remover(chave);
+            if (encontrada != chaves.end())
+                chaves.erase(encontrada);
+        }
+        else
+        {
+            arvore.inserir(chave);
+            chaves.insert(chave);
+        }
+    }
+
+    // cada chave distinta ocupa um unico nodo, logo a arvore tem no maximo 16 nodos
+    for (int chave = 0; chave <= 15; chave++)
+    {
+        if (arvore.contem(chave))
+        {
+            ASSERT_LE(*arvore.altura(chave), 4);
+        }
+    }
+
+    ASSERT_EQ(arvore.quantidade(), static_cast<int>(chaves.size()));
+    ASSERT_TRUE(std::equal(arvore.begin(), arvore.end(), chaves.begin(), chaves.end()));
+    ASSERT_TRUE(std::equal(arvore.rbegin(), arvore.rend(), chaves.rbegin(), chaves.rend()));
+
+    ListaEncadeadaAbstrata<int>* lista{arvore.emOrdem()};
+    ASSERT_EQ(lista->tamanho(), chaves.size());
+    delete lista;
+
+    std::vector<int> const ordenadas(chaves.begin(), chaves.end());
+    for (int k = 0; k < static_cast<int>(ordenadas.size()); k += 97)
+        ASSERT_EQ(*arvore.selecionar(k), ordenadas[k]);
+
+    for (int chave = 0; chave <= 16; chave++)
+    {
+        ASSERT_EQ(arvore.rank(chave), static_cast<int>(std::distance(chaves.begin(), chaves.lower_bound(chave))));
+        ASSERT_EQ(arvore.contarIntervalo(chave, chave + 2),
+                  static_cast<int>(std::distance(chaves.lower_bound(chave), chaves.upper_bound(chave + 2))));
+
+        int visitadas{0};
+        arvore.visitarIntervalo(chave, chave, [&](int const&) { visitadas++; });
+        ASSERT_EQ(visitadas, static_cast<int>(chaves.count(chave)));
+    }
+
+    // divisao, juncao e construcao a partir de chaves ordenadas preservam as contagens
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, true> direita{arvore.dividir(8)};
+    ASSERT_EQ(direita.quantidade(), static_cast<int>(std::distance(chaves.lower_bound(8), chaves.end())));
+    arvore.juntar(direita);
+    ASSERT_EQ(arvore.quantidade(), static_cast<int>(chaves.size()));
+    ASSERT_TRUE(std::equal(arvore.begin(), arvore.end(), chaves.begin(), chaves.end()));
+
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, true> construida(chaves.begin(), chaves.end());
+    ASSERT_EQ(construida.quantidade(), static_cast<int>(chaves.size()));
+    ASSERT_TRUE(std::equal(construida.begin(), construida.end(), chaves.begin(), chaves.end()));
+
+    // chaves iguais nas divisas de uma juncao ficam em um unico nodo, com as contagens somadas
+    using ArvoreContada = ArvoreAVL<int, AlocadorSlab, std::less<int>, true>;
+    std::vector<int> const cincos{5, 5, 5};
+    ArvoreContada esquerda(cincos.begin(), cincos.begin() + 2);
+    ArvoreContada maiores(cincos.begin(), cincos.end());
+    esquerda.juntar(5, maiores);
+    ASSERT_EQ(esquerda.quantidade(), 6);
+    ASSERT_EQ(esquerda.histogramaDeProfundidades(), std::vector<int>{1});
+    ArvoreContada mais_cincos(cincos.begin(), cincos.end());
+    esquerda.juntar(mais_cincos);
+    ASSERT_EQ(esquerda.quantidade(), 9);
+    ASSERT_EQ(esquerda.histogramaDeProfundidades(), std::vector<int>{1});
+    ASSERT_EQ(*esquerda.rbegin(), 5);
+
+    // inserirLote conta as chaves repetidas em vez de descarta-las
+    esquerda.inserirLote(cincos.begin(), cincos.end());
+    ASSERT_EQ(esquerda.quantidade(), 12);
+
+    // as operacoes de conjunto somam, tomam a menor ou subtraem as contagens
+    for (int tamanho : {1, 50, 3000})
+    {
+        std::uniform_int_distribution<int> faixa{0, tamanho / 3 + 1};
+        std::vector<int> a_chaves;
+        std::vector<int> b_chaves;
+        for (int i = 0; i < tamanho; i++)
+        {
+            a_chaves.push_back(faixa(gerador));
+            b_chaves.push_back(faixa(gerador));
+        }
+        std::sort(a_chaves.begin(), a_chaves.end());
+        std::sort(b_chaves.begin(), b_chaves.end());
+
+        std::vector<int> esperadas;
+        ArvoreContada a(a_chaves.begin(), a_chaves.end());
+        ArvoreContada b(b_chaves.begin(), b_chaves.end());
+        a.unir(b);
+        std::merge(a_chaves.begin(), a_chaves.end(), b_chaves.begin(), b_chaves.end(), std::back_inserter(esperadas));
+        ASSERT_EQ(a.quantidade(), static_cast<int>(esperadas.size()));
+        ASSERT_TRUE(std::equal(a.begin(), a.end(), esperadas.begin(), esperadas.end()));
+
+        esperadas.clear();
+        ArvoreContada c(a_chaves.begin(), a_chaves.end());
+        ArvoreContada d(b_chaves.begin(), b_chaves.end());
+        c.intersectar(d);
+        std::set_intersection(a_chaves.begin(), a_chaves.end(), b_chaves.begin(), b_chaves.end(), std::back_inserter(esperadas));
+        ASSERT_EQ(c.quantidade(), static_cast<int>(esperadas.size()));
+        ASSERT_TRUE(std::equal(c.begin(), c.end(), esperadas.begin(), esperadas.end()));
+
+        esperadas.clear();
+        ArvoreContada e(a_chaves.begin(), a_chaves.end());
+        ArvoreContada f(b_chaves.begin(), b_chaves.end());
+        e.subtrair(f);
+        std::set_difference(a_chaves.begin(), a_chaves.end(), b_chaves.begin(), b_chaves.end(), std::back_inserter(esperadas));
+        ASSERT_EQ(e.quantidade(), static_cast<int>(esperadas.size()));
+        ASSERT_TRUE(std::equal(e.begin(), e.end(), esperadas.begin(), esperadas.end()));
+
+        // e o lote, em cada um dos seus caminhos, conta como inserir uma a uma
+        for (int tamanho_lote : {1, 40, 20000})
+        {
+            std::vector<int> lote;
+            for (int i = 0; i < tamanho_lote; i++)
+                lote.push_back(faixa(gerador));
+
+            ArvoreContada em_lote(a_chaves.begin(), a_chaves.end());
+            std::multiset<int> repetidas(a_chaves.begin(), a_chaves.end());
+            em_lote.inserirLote(lote.begin(), lote.end());
+            repetidas.insert(lote.begin(), lote.end());
+            ASSERT_EQ(em_lote.quantidade(), static_cast<int>(repetidas.size()));
+            ASSERT_TRUE(std::equal(em_lote.begin(), em_lote.end(), repetidas.begin(), repetidas.end()));
+        }
+    }
+}
+
+TEST(ArvoreAVLTest, ComparadorEBuscaHeterogenea)
+{
+    // com std::less<>, as buscas por std::string_view nao criam std::string temporarias
+    MinhaArvoreAVL<std::string, AlocadorSlab, std::less<>> nomes;
+    for (char const* nome : {"davi", "ana", "caio", "bia", "eva"})
+        nomes.inserir(nome);
+
+    std::string_view const procurado{"caio e bia"};
+    ASSERT_TRUE(nomes.contem(procurado.substr(0, 4)));
+    ASSERT_TRUE(nomes.contem(procurado.substr(7)));
+    ASSERT_FALSE(nomes.contem(procurado));
+    ASSERT_EQ(nomes.rank(std::string_view{"c"}), 2);
+    ASSERT_EQ(nomes.contarIntervalo(std::string_view{"b"}, std::string_view{"d"}), 2);
+    ASSERT_TRUE(nomes.congelar().contem(std::string{"eva"}));
+
+    // a ordem das chaves segue o comparador em todas as operacoes
+    MinhaArvoreAVL<int, AlocadorSlab, std::greater<int>> decrescente;
+    for (int i = 0; i < 100; i++)
+        decrescente.inserir((i * 37) % 100);
+    for (int i = 0; i < 100; i += 2)
+        decrescente.remover(i);
+
+    std::vector<int> esperado;
+    for (int i = 99; i > 0; i -= 2)
+        esperado.push_back(i);
+    ASSERT_EQ(std::vector<int>(decrescente.begin(), decrescente.end()), esperado);
+    ASSERT_EQ(decrescente.rank(90), 5);
+    ASSERT_EQ(decrescente.contarIntervalo(20, 10), 5);
+    ASSERT_EQ(decrescente.contarIntervalo(10, 20), 0);
+
+    ArvoreAVL<int, AlocadorSlab, std::greater<int>> direita{decrescente.dividir(50)};
+    ASSERT_EQ(decrescente.quantidade(), 25);
+    ASSERT_EQ(*direita.begin(), 49);
+
+    // as insercoes movem a chave para o nodo, o que permite chaves que nao podem ser copiadas
+    ArvoreAVL<std::unique_ptr<int>> ponteiros;
+    std::unique_ptr<int> chave{new int{7}};
+    int const* endereco{chave.get()};
+    ponteiros.inserir(std::move(chave));
+    ASSERT_EQ(chave, nullptr);
+    ASSERT_EQ(ponteiros.begin()->get(), endereco);
+}
+
+TEST(ArvoreAVLTest, VisitantesSemAlocacao)
+{
+    std::mt19937 gerador{37};
+
+    for (int tamanho : {0, 1, 2, 3, 10, 1000})
+    {
+        std::uniform_int_distribution<int> distribuicao{0, tamanho};
+        MinhaArvoreAVL<int> arvore;
+        MinhaArvoreAVL<int, AlocadorSlab, std::less<int>, true> contadas;
+
+        for (int i = 0; i < tamanho; i++)
+        {
+            int const chave{distribuicao(gerador)};
+            arvore.inserir(chave);
+            contadas.inserir(chave);
+        }
+
+        // os visitantes percorrem as chaves na mesma ordem das listas
+        ListaEncadeadaAbstrata<int>* listas[]{arvore.emOrdem(), arvore.preOrdem(), arvore.posOrdem()};
+        std::vector<int> visitadas[3];
+        arvore.visitarEmOrdem([&](int const& e) { visitadas[0].push_back(e); });
+        arvore.visitarPreOrdem([&](int const& e) { visitadas[1].push_back(e); });
+        arvore.visitarPosOrdem([&](int const& e) { visitadas[2].push_back(e); });
+
+        for (int i = 0; i < 3; i++)
+        {
+            ASSERT_EQ(listas[i]->tamanho(), visitadas[i].size());
+            for (int const e : visitadas[i])
+                ASSERT_EQ(listas[i]->removerDoInicio(), e);
+            delete listas[i];
+        }
+
+        std::vector<int> contadas_em_ordem;
+        contadas.visitarEmOrdem([&](int const& e) { contadas_em_ordem.push_back(e); });
+        ASSERT_EQ(contadas_em_ordem, visitadas[0]);
+
+        // um visitante que retorna false interrompe o percurso
+        int limite{tamanho / 2};
+        int chamadas{0};
+        arvore.visitarPosOrdem([&](int const&) { return ++chamadas < limite; });
+        ASSERT_EQ(chamadas, std::min(std::max(limite, 1), tamanho));
+
+        chamadas = 0;
+        contadas.visitarPreOrdem([&](int const&) { return ++chamadas < limite; });
+        ASSERT_EQ(chamadas, std::min(std::max(limite, 1), tamanho));
+    }
+}
+
+TEST(ArvoreAVLTest, EstatisticasDeOperacoes)
+{
+    // sem estatisticas, a arvore nao guarda contadores nem envolve o comparador
+    static_assert(std::is_empty<ContadoresDaArvore<false>>::value);
+    static_assert(std::is_same<ComparadorDaArvore<std::less<int>, false>, std::less<int>>::value);
+
+    // insercoes em ordem crescente so exigem rotacoes simples a esquerda e formam uma arvore perfeita
+    MinhaArvoreAVL<int, AlocadorSlab, std::less<int>, false, true> arvore;
+    for (int i = 1; i <= 1023; i++)
+        arvore.inserir(i);
+
+    EstatisticasAVL estatisticas{arvore.estatisticas()};
+    ASSERT_EQ(estatisticas.alocacoes, 1023);
+    ASSERT_EQ(estatisticas.buscas, 1022);
+    ASSERT_EQ(estatisticas.rotacoesSimplesEsquerda, 1023 - 10);
+    ASSERT_EQ(estatisticas.rotacoes(), estatisticas.rotacoesSimplesEsquerda);
+    ASSERT_GT(estatisticas.subidasAoPai, 0);
+
+    std::vector<int> const histograma{arvore.histogramaDeProfundidades()};
+    double soma{0};
+    ASSERT_EQ(histograma.size(), 10u);
+    for (int profundidade = 0; profundidade < 10; profundidade++)
+    {
+        ASSERT_EQ(histograma[profundidade], 1 << profundidade);
+        soma += (profundidade + 1) * (1 << profundidade);
+    }
+    ASSERT_DOUBLE_EQ(arvore.comprimentoMedioDoCaminho(), soma / 1023);
+
+    // procurar cada chave uma vez visita, em media, o comprimento medio do caminho
+    arvore.zerarEstatisticas();
+    for (int i = 1; i <= 1023; i++)
+        ASSERT_TRUE(arvore.contem(i));
+
+    estatisticas = arvore.estatisticas();
+    ASSERT_EQ(estatisticas.buscas, 1023);
+    ASSERT_DOUBLE_EQ(estatisticas.comprimentoMedioDeBusca(), arvore.comprimentoMedioDoCaminho());
+    ASSERT_GE(estatisticas.comparacoes, estatisticas.nodosVisitados);
+    ASSERT_EQ(estatisticas.rotacoes() + estatisticas.alocacoes + estatisticas.subidasAoPai, 0);
+
+    // reconstruir a arvore libera todos os nodos antigos, mesmo quando o alocador os libera em bloco
+    arvore.zerarEstatisticas();
+    std::vector<int> const chaves{1, 2, 3};
+    arvore.construirDeOrdenado(chaves.begin(), chaves.end());
+    ASSERT_EQ(arvore.estatisticas().liberacoes, 1023);
+    ASSERT_EQ(arvore.estatisticas().alocacoes, 3);
+
+    // as rotacoes duplas contam apenas como rotacoes duplas
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, false, true> esquerda_direita;
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, false, true> direita_esquerda;
+    for (int chave : {3, 1, 2})
+        esquerda_direita.inserir(chave);
+    for (int chave : {1, 3, 2})
+        direita_esquerda.inserir(chave);
+
+    ASSERT_EQ(esquerda_direita.estatisticas().rotacoesEsquerdaDireita, 1);
+    ASSERT_EQ(esquerda_direita.estatisticas().rotacoes(), 1);
+    ASSERT_EQ(direita_esquerda.estatisticas().rotacoesDireitaEsquerda, 1);
+    ASSERT_EQ(direita_esquerda.estatisticas().rotacoes(), 1);
+
+    for (int chave : {1, 2, 3})
+        esquerda_direita.remover(chave);
+    ASSERT_EQ(esquerda_direita.estatisticas().liberacoes, 3);
+    ASSERT_TRUE(esquerda_direita.histogramaDeProfundidades().empty());
+}
+
+TEST(ArvoreAVLTest, InsercaoComDica)
+{
+    // chaves em ordem crescente, inseridas a partir do fim, custam O(1) comparacoes amortizadas
+    MinhaArvoreAVL<int, AlocadorSlab, std::less<int>, false, true> crescente;
+    std::set<int> chaves;
+    for (int i = 0; i < 100000; i++)
+    {
+        crescente.inserir(crescente.end(), i);
+        chaves.insert(i);
+    }
+
+    ASSERT_LE(crescente.estatisticas().comparacoes, 3 * 100000);
+    verificaInvariantesAVL(&crescente, chaves);
+
+    // chaves quase ordenadas, cada uma inserida a partir da anterior
+    std::mt19937 gerador{41};
+    std::uniform_int_distribution<int> atraso{0, 20};
+    MinhaArvoreAVL<int> quase_ordenada;
+    MinhaArvoreAVL<int>::Iterador dica{quase_ordenada.end()};
+    chaves.clear();
+
+    for (int i = 0; i < 20000; i++)
+    {
+        int const chave{3 * i - atraso(gerador)};
+        if (chaves.insert(chave).second)
+        {
+            dica = quase_ordenada.inserir(dica, chave);
+            ASSERT_EQ(*dica, chave);
+        }
+    }
+
+    verificaInvariantesAVL(&quase_ordenada, chaves);
+
+    // uma dica distante ou com chaves repetidas so torna a insercao mais cara, nunca errada
+    std::uniform_int_distribution<int> distribuicao{0, 50};
+    MinhaArvoreAVL<int, AlocadorSlab, std::less<int>, true> contadas;
+    ArvoreAVL<int> repetidas;
+    std::multiset<int> esperadas;
+
+    for (int i = 0; i < 5000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+        ArvoreAVL<int>::Iterador dica_repetidas{repetidas.procurar(distribuicao(gerador))};
+
+        contadas.inserir((i % 2 == 0) ? contadas.begin() : contadas.procurar(distribuicao(gerador)), chave);
+        repetidas.inserir(dica_repetidas, chave);
+        esperadas.insert(chave);
+    }
+
+    ASSERT_TRUE(std::equal(contadas.begin(), contadas.end(), esperadas.begin(), esperadas.end()));
+    ASSERT_TRUE(std::equal(repetidas.begin(), repetidas.end(), esperadas.begin(), esperadas.end()));
+    std::vector<int> const histograma{contadas.histogramaDeProfundidades()};
+    ASSERT_EQ(std::accumulate(histograma.begin(), histograma.end(), 0), 51);
+    for (int chave = 0; chave <= 50; chave++)
+        ASSERT_EQ(repetidas.rank(chave), contadas.rank(chave));
+}
+
+/**
+ * @brief compara uma consulta que retorna std::optional com o iterador equivalente de um conjunto
+ */
+template <typename Conjunto>
+static std::optional<int> chaveOuNada(Conjunto const& chaves, typename Conjunto::const_iterator posicao)
+{
+    return (posicao == chaves.end()) ? std::nullopt : std::optional<int>{*posicao};
+}
+
+template <typename Arvore, typename Conjunto>
+static void verificaVizinhos(Arvore const& arvore, Conjunto const& chaves, int chave)
+{
+    ASSERT_EQ(arvore.minimo(), chaves.empty() ? std::nullopt : std::optional<int>{*chaves.begin()});
+    ASSERT_EQ(arvore.maximo(), chaves.empty() ? std::nullopt : std::optional<int>{*chaves.rbegin()});
+
+    typename Conjunto::const_iterator inferior{chaves.lower_bound(chave)};
+    typename Conjunto::const_iterator superior{chaves.upper_bound(chave)};
+
+    ASSERT_EQ(arvore.teto(chave), chaveOuNada(chaves, inferior));
+    ASSERT_EQ(arvore.sucessor(chave), chaveOuNada(chaves, superior));
+    ASSERT_EQ(arvore.piso(chave), (superior == chaves.begin()) ? std::nullopt : std::optional<int>{*std::prev(superior)});
+    ASSERT_EQ(arvore.antecessor(chave), (inferior == chaves.begin()) ? std::nullopt : std::optional<int>{*std::prev(inferior)});
+    ASSERT_EQ(std::distance(arvore.begin(), arvore.lower_bound(chave)), std::distance(chaves.begin(), inferior));
+    ASSERT_EQ(std::distance(arvore.begin(), arvore.upper_bound(chave)), std::distance(chaves.begin(), superior));
+}
+
+TEST(ArvoreAVLTest, ConsultasDeVizinhanca)
+{
+    MinhaArvoreAVL<int> arvore;
+    std::set<int> chaves;
+    std::mt19937 gerador{43};
+    std::uniform_int_distribution<int> distribuicao{0, 400};
+
+    verificaVizinhos(arvore, chaves, 0);
+    ASSERT_TRUE(arvore.lower_bound(0) == arvore.end());
+
+    // os extremos acompanham insercoes e remocoes, inclusive da menor e da maior chave
+    for (int i = 0; i < 3000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+        if (i % 3 == 2)
+        {
+            arvore.remover(chave);
+            chaves.erase(chave);
+            arvore.remover(*arvore.minimo());
+            chaves.erase(chaves.begin());
+        }
+        else if (chaves.insert(chave).second)
+        {
+            (i % 2 == 0) ? arvore.inserir(chave) : static_cast<void>(arvore.inserir(arvore.end(), chave));
+        }
+
+        verificaVizinhos(arvore, chaves, distribuicao(gerador));
+    }
+
+    ASSERT_EQ(*--arvore.end(), *chaves.rbegin());
+
+    // e as operacoes que trocam subarvores inteiras
+    ArvoreAVL<int> direita{arvore.dividir(200)};
+    std::set<int> const chaves_direita(chaves.lower_bound(200), chaves.end());
+    chaves.erase(chaves.lower_bound(200), chaves.end());
+    verificaVizinhos(arvore, chaves, 200);
+    verificaVizinhos(direita, chaves_direita, 200);
+
+    std::vector<int> lote(1000);
+    std::iota(lote.begin(), lote.end(), 1000);
+    arvore.inserirLote(lote.begin(), lote.end());
+    chaves.insert(lote.begin(), lote.end());
+    verificaVizinhos(arvore, chaves, 999);
+
+    MinhaArvoreAVL<int> outra;
+    outra.inserirLote(chaves_direita.begin(), chaves_direita.end());
+    arvore.unir(outra);
+    chaves.insert(chaves_direita.begin(), chaves_direita.end());
+    verificaVizinhos(arvore, chaves, 200);
+    verificaVizinhos(outra, std::set<int>{}, 200);
+
+    // com repeticoes, a chave so deixa de ser extremo quando sua ultima repeticao e removida
+    MinhaArvoreAVL<int, AlocadorSlab, std::less<int>, true> contadas;
+    std::multiset<int> repetidas;
+    for (int i = 0; i < 2000; i++)
+    {
+        int const chave{distribuicao(gerador) % 40};
+        if (i % 4 == 3)
+        {
+            contadas.remover(chave);
+            if (repetidas.count(chave) > 0)
+                repetidas.erase(repetidas.find(chave));
+        }
+        else
+        {
+            contadas.inserir(chave);
+            repetidas.insert(chave);
+        }
+
+        verificaVizinhos(contadas, repetidas, distribuicao(gerador) % 40);
+    }
+
+    // busca heterogenea com comparador transparente
+    ArvoreAVL<std::string, AlocadorSlab, std::less<>> nomes;
+    nomes.inserir("bia");
+    nomes.inserir("davi");
+    ASSERT_EQ(*nomes.lower_bound(std::string_view{"c"}), "davi");
+    ASSERT_TRUE(nomes.upper_bound(std::string_view{"davi"}) == nomes.end());
+    ASSERT_EQ(nomes.piso("c"), std::optional<std::string>{"bia"});
+}
+
+/**
+ * @brief Serializador de retratos para std::string: o tamanho e depois os caracteres.
+ */
+struct SerializadorDeTexto
+{
+    void escrever(std::string const& chave, EscritorDeRetrato& escritor) const
+    {
+        escritor.escreverValor(static_cast<std::uint32_t>(chave.size()));
+        escritor.escrever(chave.data(), chave.size());
+    }
+
+    std::string ler(LeitorDeRetrato& leitor) const
+    {
+        std::string chave(leitor.lerValor<std::uint32_t>(), '\0');
+        leitor.ler(chave.data(), chave.size());
+        return chave;
+    }
+};
+
+TEST(ArvoreAVLTest, RetratoBinario)
+{
+    // chaves suficientes para que o retrato seja maior que o buffer de leitura e escrita
+    std::mt19937 gerador{31};
+    std::uniform_int_distribution<int> distribuicao{0, 1 << 30};
+    std::set<int> chaves;
+
+    MinhaArvoreAVL<int> arvore;
+    while (chaves.size() < 300000)
+    {
+        int const chave{distribuicao(gerador)};
+        if (chaves.insert(chave).second)
+            arvore.inserir(chave);
+    }
+
+    std::stringstream fluxo;
+    arvore.salvar(fluxo);
+    std::string const retrato{fluxo.str()};
+    ASSERT_EQ(retrato.size(), 24 + chaves.size() * sizeof(int) + 8);
+
+    MinhaArvoreAVL<int> carregada;
+    carregada.inserir(-1);
+    carregada.carregar(fluxo);
+    verificaInvariantesAVL(&carregada, chaves);
+
+    // retratos corrompidos, truncados ou de outro tipo de chave sao recusados sem alterar a arvore
+    std::string corrompido{retrato};
+    corrompido[1000] ^= 1;
+    std::string truncado{retrato, 0, retrato.size() - 1};
+
+    // um cabecalho valido que anuncia muito mais chaves do que o retrato contem
+    std::string quantidade_falsa{retrato, 0, 24 + 16};
+    std::uint64_t const quantidade_anunciada{0x7fffffff};
+    std::memcpy(&quantidade_falsa[16], &quantidade_anunciada, sizeof(quantidade_anunciada));
+
+    for (std::string const& invalido : {corrompido, truncado, quantidade_falsa, std::string{"AVLT"}, std::string{}})
+    {
+        std::stringstream entrada{invalido};
+        ASSERT_THROW(carregada.carregar(entrada), ExcecaoRetratoInvalido);
+        ASSERT_EQ(carregada.quantidade(), static_cast<int>(chaves.size()));
+    }
+
+    std::stringstream como_int64{retrato};
+    ArvoreAVL<std::int64_t> outra;
+    ASSERT_THROW(outra.carregar(como_int64), ExcecaoRetratoInvalido);
+
+    // repeticoes sao gravadas uma vez por contagem
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, true> contadas;
+    for (int i = 0; i < 100; i++)
+        contadas.inserir(i % 7);
+
+    std::stringstream fluxo_contadas;
+    contadas.salvar(fluxo_contadas);
+    ArvoreAVL<int, AlocadorSlab, std::less<int>, true> contadas_carregadas;
+    contadas_carregadas.carregar(fluxo_contadas);
+    ASSERT_EQ(contadas_carregadas.quantidade(), 100);
+    ASSERT_TRUE(std::equal(contadas.begin(), contadas.end(), contadas_carregadas.begin(), contadas_carregadas.end()));
+
+    // chaves que nao sao trivialmente copiaveis usam um serializador proprio
+    MinhaArvoreAVL<std::string> nomes;
+    for (char const* nome : {"davi", "ana", "", "caio", "bia", "eva"})
+        nomes.inserir(nome);
+
+    std::stringstream fluxo_nomes;
+    nomes.salvar(fluxo_nomes, SerializadorDeTexto{});
+    MinhaArvoreAVL<std::string> nomes_carregados;
+    nomes_carregados.carregar(fluxo_nomes, SerializadorDeTexto{});
+    ASSERT_TRUE(std::equal(nomes.begin(), nomes.end(), nomes_carregados.begin(), nomes_carregados.end()));
+
+    std::stringstream fluxo_decrescente{fluxo_nomes.str()};
+    MinhaArvoreAVL<std::string, AlocadorSlab, std::greater<std::string>> decrescente;
+    ASSERT_THROW(decrescente.carregar(fluxo_decrescente, SerializadorDeTexto{}), ExcecaoRetratoInvalido);
+}
+
+/**
+ * @brief Valor que conta quantas vezes foi construido, copiado ou movido.
+ */
+struct ValorContado
+{
+    static inline int construcoes{0};
+    static inline int copiasOuMovimentos{0};
+
+    int valor;
+
+    explicit ValorContado(int valor = -1) : valor{valor} { construcoes++; }
+    ValorContado(ValorContado const& outro) : valor{outro.valor} { copiasOuMovimentos++; }
+    ValorContado(ValorContado&& outro) : valor{outro.valor} { copiasOuMovimentos++; }
+    ValorContado& operator=(ValorContado const&) = default;
+    ValorContado& operator=(ValorContado&&) = default;
+};
+
+TEST(MeuMapaAVLTest, OperacoesDeMapa)
+{
+    std::mt19937 gerador{17};
+    std::uniform_int_distribution<int> distribuicao{0, 300};
+
+    MeuMapaAVL<int, int> mapa;
+    std::map<int, int> esperado;
+
+    for (int i = 0; i < 5000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+
+        switch (i % 4)
+        {
+        case 0:
+            ASSERT_EQ(mapa.try_emplace(chave, i).second, esperado.try_emplace(chave, i).second);
+            break;
+        case 1:
+            ASSERT_EQ(mapa.insert_or_assign(chave, i).second, esperado.insert_or_assign(chave, i).second);
+            break;
+        case 2:
+            mapa[chave] += i;
+            esperado[chave] += i;
+            break;
+        default:
+            ASSERT_EQ(mapa.remover(chave), esperado.erase(chave) == 1);
+        }
+
+        MeuMapaAVL<int, int>::iterator const encontrada{mapa.find(chave)};
+        ASSERT_EQ(encontrada == mapa.end(), esperado.count(chave) == 0);
+        if (encontrada != mapa.end())
+        {
+            ASSERT_EQ(encontrada->second, esperado[chave]);
+        }
+    }
+
+    ASSERT_EQ(mapa.quantidade(), static_cast<int>(esperado.size()));
+    ASSERT_TRUE(std::equal(mapa.begin(), mapa.end(), esperado.begin(), esperado.end()));
+    for (int chave = -1; chave <= 301; chave += 7)
+    {
+        ASSERT_TRUE(std::equal(mapa.lower_bound(chave), mapa.upper_bound(chave + 7),
+                               esperado.lower_bound(chave), esperado.upper_bound(chave + 7)));
+    }
+
+    // o valor e construido uma unica vez, dentro do nodo, e nao e construido se a chave ja existe
+    MeuMapaAVL<std::string, ValorContado> valores;
+    ValorContado::construcoes = 0;
+    ValorContado::copiasOuMovimentos = 0;
+
+    ASSERT_TRUE(valores.try_emplace("um", 1).second);
+    ASSERT_FALSE(valores.try_emplace("um", 2).second);
+    ASSERT_EQ(valores["dois"].valor, -1);
+    valores.find("dois")->second.valor = 2;
+    ASSERT_EQ(valores["dois"].valor, 2);
+    ASSERT_EQ(valores.find("um")->second.valor, 1);
+    ASSERT_EQ(ValorContado::construcoes, 2);
+    ASSERT_EQ(ValorContado::copiasOuMovimentos, 0);
+}
+
+TEST(ArvoreAVLTest, OperacoesDeConjunto)
+{
+    std::mt19937 gerador{11};
+    PoolDeThreads pool{3};
+
+    // tamanhos pequenos sao processados sem tarefas; os grandes usam o pool
+    for (int tamanho : {0, 1, 50, 20000})
+    {
+        for (int rodada = 0; rodada < 3; rodada++)
+        {
+            std::uniform_int_distribution<int> distribuicao{0, 3 * tamanho + 1};
+            std::set<int> a;
+            std::set<int> b;
+
+            for (int i = 0; i < tamanho; i++)
+            {
+                a.insert(distribuicao(gerador));
+                b.insert(distribuicao(gerador));
+            }
+
+            std::vector<int> esperado;
+            MinhaArvoreAVL<int> uniao(a.begin(), a.end());
+            MinhaArvoreAVL<int> outra(b.begin(), b.end());
+            uniao.unir(outra, pool);
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(esperado));
+            ASSERT_TRUE(outra.vazia());
+            verificaInvariantesAVL(&uniao, std::set<int>(esperado.begin(), esperado.end()));
+
+            esperado.clear();
+            MinhaArvoreAVL<int> intersecao(a.begin(), a.end());
+            MinhaArvoreAVL<int> outra2(b.begin(), b.end());
+            intersecao.intersectar(outra2, pool);
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(esperado));
+            verificaInvariantesAVL(&intersecao, std::set<int>(esperado.begin(), esperado.end()));
+
+            esperado.clear();
+            MinhaArvoreAVL<int> diferenca(a.begin(), a.end());
+            MinhaArvoreAVL<int> outra3(b.begin(), b.end());
+            diferenca.subtrair(outra3, pool);
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(esperado));
+            verificaInvariantesAVL(&diferenca, std::set<int>(esperado.begin(), esperado.end()));
+            ASSERT_EQ(std::vector<int>(diferenca.rbegin(), diferenca.rend()), std::vector<int>(esperado.rbegin(), esperado.rend()));
+        }
+    }
+}
+
+TEST(ArvoreAVLConcorrenteTest, LeitoresSemTravaComEscritor)
+{
+    ArvoreAVLConcorrente<int> arvore;
+    std::set<int> chaves;
+    std::mt19937 gerador{13};
+    std::uniform_int_distribution<int> distribuicao{0, 999};
+
+    for (int i = 0; i < 5000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+
+        if (i % 3 == 2)
+            ASSERT_EQ(arvore.remover(chave), chaves.erase(chave) == 1);
+        else
+            ASSERT_EQ(arvore.inserir(chave), chaves.insert(chave).second);
+    }
+
+    ASSERT_EQ(arvore.quantidade(), static_cast<int>(chaves.size()));
+    for (int chave = 0; chave < 1000; chave++)
+        ASSERT_EQ(arvore.contem(chave), chaves.count(chave) == 1);
+    ASSERT_EQ(arvore.contarIntervalo(100, 500), static_cast<int>(std::distance(chaves.lower_bound(100), chaves.upper_bound(500))));
+
+    // a maior altura e a da raiz, limitada em uma AVL por 1.44 log2(n + 2)
+    int maior_altura{0};
+    for (int const chave : chaves)
+        maior_altura = std::max(maior_altura, *arvore.altura(chave));
+    ASSERT_LE(maior_altura, 1.44 * std::log2(chaves.size() + 2));
+
+    // chaves pares ficam na arvore o tempo todo; o escritor insere e remove as impares
+    ArvoreAVLConcorrente<int> compartilhada;
+    for (int chave = 0; chave < 4000; chave += 2)
+        compartilhada.inserir(chave);
+
+    std::atomic<bool> terminou{false};
+    std::atomic<int> erros{0};
+    std::vector<std::thread> leitores;
+
+    for (int leitor = 0; leitor < 3; leitor++)
+    {
+        leitores.emplace_back([&, leitor] {
+            std::mt19937 gerador_leitor(leitor);
+            while (!terminou.load())
+            {
+                int const chave{static_cast<int>(gerador_leitor() % 2000) * 2};
+                if (!compartilhada.contem(chave) || compartilhada.contem(-1) || !compartilhada.altura(chave).has_value())
+                    erros++;
+
+                std::vector<int> visitadas;
+                compartilhada.visitarIntervalo(chave, chave + 100, [&](int const& visitada) { visitadas.push_back(visitada); });
+                if (!std::is_sorted(visitadas.begin(), visitadas.end()) ||
+                    std::count_if(visitadas.begin(), visitadas.end(), [](int v) { return v % 2 == 0; }) != std::min(51, (4000 - chave) / 2))
+                    erros++;
+            }
+        });
+    }
+
+    for (int rodada = 0; rodada < 20; rodada++)
+    {
+        for (int chave = 1; chave < 4000; chave += 2)
+            compartilhada.inserir(chave);
+        for (int chave = 3999; chave > 0; chave -= 2)
+            compartilhada.remover(chave);
+    }
+
+    terminou = true;
+    for (std::thread& leitor : leitores)
+        leitor.join();
+
+    ASSERT_EQ(erros.load(), 0);
+    ASSERT_EQ(compartilhada.quantidade(), 2000);
+}
+
+TEST(ArvoreAVLCompactaTest, InsercaoERemocaoComFatorDeBalanceamento)
+{
+    std::mt19937 gerador{31};
+    std::uniform_int_distribution<int> distribuicao{0, 4000};
+
+    ArvoreAVLCompacta<int> arvore;
+    std::multiset<int> chaves;
+
+    for (int i = 0; i < 30000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+
+        if (i % 3 == 2)
+        {
+            std::multiset<int>::iterator const encontrada{chaves.find(chave)};
+            ASSERT_EQ(arvore.remover(chave), encontrada != chaves.end());
+            if (encontrada != chaves.end())
+                chaves.erase(encontrada);
+        }
+        else
+        {
+            arvore.inserir(chave);
+            chaves.insert(chave);
+        }
+
+        ASSERT_EQ(arvore.contem(chave), chaves.count(chave) > 0);
+    }
+
+    // a altura de uma arvore AVL com n chaves e menor que 1.45 log2(n + 2)
+    ASSERT_EQ(arvore.quantidade(), static_cast<int>(chaves.size()));
+    ASSERT_LT(arvore.altura(), 1.45 * std::log2(chaves.size() + 2));
+
+    ListaEncadeadaAbstrata<int>* lista{arvore.emOrdem()};
+    for (int const e : chaves)
+        ASSERT_EQ(lista->removerDoInicio(), e);
+    ASSERT_TRUE(lista->vazia());
+    delete lista;
+
+    // os nodos removidos sao reaproveitados, sem reservar mais memoria
+    std::size_t const reservados{arvore.bytesReservados()};
+    for (int const e : chaves)
+        ASSERT_TRUE(arvore.remover(e));
+    ASSERT_TRUE(arvore.vazia());
+    for (int const e : chaves)
+        arvore.inserir(e);
+    ASSERT_EQ(arvore.bytesReservados(), reservados);
+    ASSERT_LT(reservados, (chaves.size() + 4096) * 12);
+}
+
+TEST(ArvoreAVLPersistenteTest, RetratosNaoMudamComAlteracoes)
+{
+    std::mt19937 gerador{17};
+    std::uniform_int_distribution<int> distribuicao{0, 299};
+
+    ArvoreAVLPersistente<int> arvore;
+    std::multiset<int> chaves;
+    std::vector<std::pair<ArvoreAVLPersistente<int>, std::multiset<int>>> retratos;
+
+    for (int i = 0; i < 3000; i++)
+    {
+        int const chave{distribuicao(gerador)};
+
+        if (i % 3 == 2)
+        {
+            arvore.remover(chave);
+            if (chaves.count(chave) > 0)
+                chaves.erase(chaves.find(chave));
+        }
+        else
+        {
+            arvore.inserir(chave);
+            chaves.insert(chave);
+        }
+
+        if (i % 200 == 0)
+            retratos.emplace_back(arvore.retrato(), chaves);
+    }
+
+    retratos.emplace_back(std::move(arvore), chaves);
+
+    // cada retrato mantem as chaves do momento em que foi tirado, mesmo apos o original sumir
+    for (auto const& [retrato, esperadas] : retratos)
+    {
+        ASSERT_EQ(retrato.quantidade(), static_cast<int>(esperadas.size()));
+
+        ListaEncadeadaAbstrata<int>* lista{retrato.emOrdem()};
+        for (int const e : esperadas)
+            ASSERT_EQ(lista->removerDoInicio(), e);
+        ASSERT_TRUE(lista->vazia());
+        delete lista;
+
+        for (int const e : esperadas)
+        {
+            ASSERT_TRUE(retrato.contem(e));
+            ASSERT_LE(*retrato.altura(e), 1.44 * std::log2(esperadas.size() + 2));
+        }
+        ASSERT_FALSE(retrato.contem(-1));
+    }
+
+    std::vector<int> const ordenadas{1, 2, 3, 5, 8, 13, 21};
+    ArvoreAVLPersistente<int> construida(ordenadas.begin(), ordenadas.end());
+    ASSERT_EQ(construida.quantidade(), 7);
+    ASSERT_EQ(*construida.altura(5), 2);
+}
+
+TEST(ListaEncadeadaTest, InsercaoRemocaoNoFimEConcatenacao)
+{
+    ListaEncadeadaAbstrata<int>* const lista{new MinhaListaEncadeada<int>};
+    ListaEncadeadaAbstrata<int>* const outra{new MinhaListaEncadeada<int>};
+
+    for (int const e : {1, 2, 3})
+        lista->inserirNoFim(e);
+
+    ASSERT_EQ(lista->removerDoFim(), 3);
+    ASSERT_EQ(lista->tamanho(), 2);
+
+    lista->inserirNoFim(4);
+    lista->inserirNoInicio(0);
+
+    for (int const e : {5, 6})
+        outra->inserirNoFim(e);
+
+    lista->concatenar(*outra);
+    ASSERT_TRUE(outra->vazia());
+    ASSERT_EQ(outra->tamanho(), 0);
+    ASSERT_EQ(lista->tamanho(), 6);
+
+    // a lista esvaziada continua utilizavel
+    outra->inserirNoFim(7);
+    lista->concatenar(*outra);
+    ASSERT_EQ(lista->tamanho(), 7);
+
+    for (int const e : {7, 6, 5})
+        ASSERT_EQ(lista->removerDoFim(), e);
+
+    for (int const e : {0, 1, 2, 4})
+        ASSERT_EQ(lista->removerDoInicio(), e);
+
+    ASSERT_TRUE(lista->vazia());
+
+    // remover o ultimo item tambem esvazia o fim da lista
+    lista->inserirNoFim(8);
+    ASSERT_EQ(lista->removerDoInicio(), 8);
+    lista->inserirNoFim(9);
+    ASSERT_EQ(lista->removerDoFim(), 9);
+    ASSERT_TRUE(lista->vazia());
+
+    delete outra;
+    delete lista;
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);